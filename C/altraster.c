@@ -0,0 +1,206 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+/* a row is done in blocks of this many cells */
+#define ALTITUDE_BLOCK		256
+
+/* kernel loops for each instruction set, see altraster_kernels.h */
+#define BATCH_KERNELS	"altraster_kernels.h"
+#include "batchisa.h"
+
+/* reference loop, the computation of azimuth_altitude with the C library */
+static void altitude_row_scalar(const double *x, const double *yc,
+	double sinPhi, double cosPhi, double sinDelta, double *h, double *A, int n)
+{
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		if ( A != NULL )
+			A[i] = atan2(x[i], yc[i] * sinPhi - sinDelta * cosPhi) * kRadDeg;
+
+		h[i] = asin(sinPhi * sinDelta + cosPhi * yc[i]) * kRadDeg;
+	}
+}
+
+/* dispatch table indexed by IsaLevels */
+static void (* const altitude_row[])(const double *x, const double *yc,
+	double sinPhi, double cosPhi, double sinDelta, double *h, double *A, int n) =
+	BATCH_FUNCTIONS(altitude_row);
+
+/* the columns and the outputs of a raster */
+typedef struct
+{
+	void			(*kernel)(const double *, const double *, double, double, double, double *, double *, int);
+	const double	*x, *yc;
+	double			sinDelta, phi0, dphi;
+	int				cols;
+	double			*h, *A;
+	float			*hf, *Af;
+} AltitudeRaster;
+
+/* the rows begin to end, one chunk of aa_parallel_for */
+static void altitude_rows(void *context, int begin, int end)
+{
+	const AltitudeRaster	*raster = (const AltitudeRaster *) context;
+	double					sinPhi, cosPhi, hb[ALTITUDE_BLOCK], Ab[ALTITUDE_BLOCK];
+	size_t					row;
+	int						r, i, k, len, cols = raster->cols;
+
+	for ( r = begin; r < end; ++r )
+	{
+		row = (size_t) r * (size_t) cols;
+
+		SinCosD(raster->phi0 + r * raster->dphi, &sinPhi, &cosPhi);
+
+		for ( i = 0; i < cols; i += ALTITUDE_BLOCK )
+		{
+			len = ( cols - i < ALTITUDE_BLOCK ) ? cols - i : ALTITUDE_BLOCK;
+
+			if ( raster->h != NULL )
+			{
+				raster->kernel(raster->x + i, raster->yc + i, sinPhi, cosPhi, raster->sinDelta,
+					raster->h + row + i, ( raster->A != NULL ) ? raster->A + row + i : NULL, len);
+				continue;
+			}
+
+			raster->kernel(raster->x + i, raster->yc + i, sinPhi, cosPhi, raster->sinDelta,
+				hb, ( raster->Af != NULL ) ? Ab : NULL, len);
+
+			for ( k = 0; k < len; ++k )
+				raster->hf[row + i + k] = (float) hb[k];
+
+			if ( raster->Af != NULL )
+				for ( k = 0; k < len; ++k )
+					raster->Af[row + i + k] = (float) Ab[k];
+		}
+	}
+}
+
+/* the raster into double or float outputs, the others NULL */
+static int altitude_raster(double JD, double phi0, double dphi, int rows, double L0, double dL, int cols,
+	double h[], double A[], float hf[], float Af[])
+{
+	AltitudeRaster	raster;
+	double			alpha, delta, theta0, cosDelta, sinH, cosH, *x, *yc;
+	int				j;
+
+	/* the altitude is not optional */
+	if ( rows <= 0 || cols <= 0 || (h == NULL && hf == NULL) )
+		return 0;
+
+	/* the sun and the sidereal time, once for the whole raster */
+	app_solar_coordinates(JD, &alpha, &delta);
+	theta0 = app_sidereal_time(JD);
+
+	SinCosD(delta, &raster.sinDelta, &cosDelta);
+
+	/* the hour angle trig of the columns, the same at every latitude */
+	x = (double *) malloc(2 * (size_t) cols * sizeof(double));
+	if ( x == NULL )
+		return 0;
+	yc = x + cols;
+
+	for ( j = 0; j < cols; ++j )
+	{
+		SinCosD(Revolution(theta0 - (L0 + j * dL) - alpha), &sinH, &cosH);
+		x[j] = cosDelta * sinH;
+		yc[j] = cosDelta * cosH;
+	}
+
+	raster.kernel = altitude_row[aa_get_isa()];
+	raster.x = x;
+	raster.yc = yc;
+	raster.phi0 = phi0;
+	raster.dphi = dphi;
+	raster.cols = cols;
+	raster.h = h;
+	raster.A = A;
+	raster.hf = hf;
+	raster.Af = Af;
+
+	aa_parallel_for(rows, 1 + AA_PARALLEL_CELLS / cols, altitude_rows, &raster);
+
+	free(x);
+
+	return 1;
+}
+
+/*******************************************************************************
+	NAME:
+		solar_altitude_raster
+		solar_altitude_raster_f
+
+	PURPOSE:
+		Computes the altitude, and optionally the azimuth, of the sun over a
+		latitude and longitude grid at one instant, for day and night maps
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 87-90
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day UT
+		phi0, dphi (double)
+			latitude of the first row and the step between rows in degrees
+		rows (int)
+			number of rows
+		L0, dL (double)
+			longitude of the first column and the step between columns in
+			degrees, positive west
+		cols (int)
+			number of columns
+
+	OUTPUT ARGUMENTS:
+		h[] (double or float)
+			altitude in degrees, rows * cols, row major
+		A[] (double or float)
+			azimuth in degrees west of south, rows * cols, or NULL
+
+	RETURNED VALUE:
+		1 on success, 0 for an empty grid, a NULL h or when out of memory
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		app_solar_coordinates, app_sidereal_time, aa_get_isa, SinCosD,
+		Revolution, aa_asind_kernel, aa_atan2d_kernel, aa_parallel_for
+
+	NOTES:
+		Every cell gives what azimuth_altitude gives with the sun from
+		app_solar_coordinates, within 1e-8 degrees, or the rounding to float
+		for solar_altitude_raster_f.  The sun is above the horizon where h
+		is positive, and the terminator is where h is -0.8333.
+
+		The sun and the sidereal time are computed once.  The trig splits by
+		rows and columns, the hour angle only depends on the longitude and
+		the latitude only on the row, so a cell is a few products and asin,
+		and atan2 for the azimuth, with the kernels of astrointernal.h in
+		loops that vectorize.  The rows are spread over the threads of
+		aa_set_threads().
+		The outputs must not overlap.
+
+********************************************************************************/
+int solar_altitude_raster(double JD, double phi0, double dphi, int rows, double L0, double dL, int cols,
+	double h[], double A[])
+{
+	return altitude_raster(JD, phi0, dphi, rows, L0, dL, cols, h, A, NULL, NULL);
+}
+
+int solar_altitude_raster_f(double JD, double phi0, double dphi, int rows, double L0, double dL, int cols,
+	float h[], float A[])
+{
+	return altitude_raster(JD, phi0, dphi, rows, L0, dL, cols, NULL, NULL, h, A);
+}
@@ -0,0 +1,22 @@
+/* solar altitude raster kernels, included once per instruction set */
+/* by altraster.c through batchisa.h, no include guard */
+
+/* altitude, and azimuth when A is not NULL, along part of a latitude row given */
+/* x = cos delta sin H and yc = cos delta cos H of the columns, no branches or calls */
+/* in the loops */
+static BATCH_TARGET void BATCH_NAME(altitude_row)(const double *x, const double *yc,
+	double sinPhi, double cosPhi, double sinDelta, double * AA_RESTRICT h, double * AA_RESTRICT A, int n)
+{
+	double	z = sinDelta * cosPhi, c = sinDelta * sinPhi;
+	int		i;
+
+	/* the horizontal coordinates, pp. 89 */
+	for ( i = 0; i < n; ++i )
+		h[i] = aa_asind_kernel(c + cosPhi * yc[i]);
+
+	if ( A == NULL )
+		return;
+
+	for ( i = 0; i < n; ++i )
+		A[i] = aa_atan2d_kernel(x[i], yc[i] * sinPhi - z);
+}
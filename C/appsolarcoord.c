@@ -1,5 +1,6 @@
 #include "astroalgo.h"
 #include "astromath.h"
+#include "astrointernal.h"
 
 /* C Headers */
 #include <math.h>
@@ -17,7 +18,8 @@
 *			
 *	INPUT ARGUMENTS:
 *		JD (double)
-*			Julian Day for day/time to calculate  at TD
+*			Julian Day for day/time to calculate  at TD, at UT when
+*			aa_set_auto_delta_t() is on
 *	
 *	OUTPUT ARGUMENTS:
 *	 	*alpha (double)
@@ -32,7 +34,7 @@
 *	 	none
 *	 
 *	FUNCTIONS CALLED:
-*	 	SinD, CosD, Revolution, atan2
+*	 	SinCosD, CosD, Revolution, atan2, ut_to_tt
 *	 
 *	DATE/PROGRAMMER/NOTE:
 *	 	09-16-1999	Todd A. Guillory	created
@@ -42,34 +44,72 @@
 ********************************************************************************/
 void app_solar_coordinates( double JD, double *alpha, double *delta)
 {
-	double	T,		/* Julian Centuries */
-			L0,		/* geometric mean longitude of the sun */
-			M,		/* mean anomoly */
+	double	lambda, R, E;
+	
+	if ( aa_get_auto_delta_t() )
+		JD = ut_to_tt(JD);
+	
+	solar_coordinates_T(julian_centuries(JD), alpha, delta, &lambda, &R, &E);
+}
+
+/* as app_solar_coordinates, the instant t at TD, or UT when DeltaT is applied */
+void app_solar_coordinates_instant( aaInstant t, double *alpha, double *delta)
+{
+	double	T = instant_centuries(t),
+			lambda, R, E;
+	
+	if ( aa_get_auto_delta_t() )
+		T += delta_t(instant_to_julian(t)) / (86400.0 * 36525.0);
+	
+	solar_coordinates_T(T, alpha, delta, &lambda, &R, &E);
+}
+
+/* as app_solar_coordinates, with T from the epoch, the same result bit for bit. */
+/* The epoch's M and omega are the lunar theory's, pp. 308, and are not used: */
+/* they differ from the solar theory's by up to 2e-5 and 7e-3 degrees */
+void app_solar_coordinates_ctx( const aaEpoch *epoch, double *alpha, double *delta)
+{
+	double	lambda, R, E;
+	
+	solar_coordinates_T(epoch->T, alpha, delta, &lambda, &R, &E);
+}
+
+/* the computation of app_solar_coordinates for T Julian centuries from J2000.0, */
+/* also gives the apparent longitude lambda in degrees, the radius vector R in AU */
+/* and the equation of time E in minutes */
+/* internal, declared in astrointernal.h */
+void solar_coordinates_T( double T, double *alpha, double *delta, double *lambda, double *R, double *E)
+{
+	double	L0,		/* geometric mean longitude of the sun */
+			M,		/* mean anomaly of the sun */
+			omega,	/* longitude of the moon's ascending node */
 			e,		/* eccentricity of Earth's orbit */
 			C,		/* Sun's equation of center */
 			Long,	/* true longitude of the sun */
 			v,		/* true anomaly of the sun */
-			R,		/* Radius in AU */
-			omega,	/* nutation */
 			lamda,	/* apparent longitude of the sun */
-			ep0;	/* mean obliquity of the ecliptic */
+			ep0,	/* mean obliquity of the ecliptic */
+			sinM, cosM,
+			sinOmega, cosOmega,
+			sinLamda, cosLamda,
+			sinEp0, cosEp0;
 
-	/* Get Julian Centuries */
-	T = julian_centuries(JD);
-	
 	/* calculate the geometric mean longitude of the sun */
 	L0 = 280.46645 + 36000.76983 * T + 0.0003032 * T * T;
 	
-	/* calculate the mean anomaly of the sun */
+	/* mean anomaly of the sun and longitude of the moon's node, pp. 151-152 */
 	M = 357.52910 + 35999.05030 * T - 0.0001559 * T * T - 0.00000048 * T * T * T;
+	omega = 125.04 - 1934.136 * T;
 	
 	/* calculate the eccentricity of the Earth's Orbit */
 	e = 0.016708617 - 0.000042037 * T - 0.0000001236 * T * T;
 	
 	/* calculate the sun's equation of center */
-	C = (1.914600 - 0.004817 * T - 0.000014 * T * T) * SinD(M)
-		+ (0.019993 - 0.000101 * T) * SinD(2*M)
-		+ 0.000290 * SinD(3*M);
+	/* sin 2M and sin 3M from the multiple angle formulas */
+	SinCosD(M, &sinM, &cosM);
+	C = (1.914600 - 0.004817 * T - 0.000014 * T * T) * sinM
+		+ (0.019993 - 0.000101 * T) * 2.0 * sinM * cosM
+		+ 0.000290 * sinM * (3.0 - 4.0 * sinM * sinM);
 	
 	/* calculate the sun's true longitude */	
 	Long = L0 + C;
@@ -78,21 +118,87 @@ void app_solar_coordinates( double JD, double *alpha, double *delta)
 	v = M + C;
 	
 	/* calculate the sun's radius vector, distance of the earth in AUs */
-	R = (1.000001018 * ( 1 - e * e)) / ( 1 + e * CosD(v) );
+	*R = (1.000001018 * ( 1 - e * e)) / ( 1 + e * CosD(v) );
 	
-	omega = 125.04 - 1934.136 * T;
+	SinCosD(omega, &sinOmega, &cosOmega);
 	
 	/* calculate the apparent longitude of the sun */
-	lamda = Revolution(Long - 0.00569 - 0.00478 * SinD(omega));
+	lamda = Revolution(Long - 0.00569 - 0.00478 * sinOmega);
 	
 	/* calculate the mean obliquity of the ecliptic */
 	ep0 = ((23*60)+26)*60+21.448 - 46.8150 * T - 0.00059 * T * T + 0.001813 * T * T * T;
 	ep0 /= 3600;
 	
 	/* correct mean obliquity of the ecliptic */
-	ep0 = ep0 + 0.00256 * CosD(omega);
+	ep0 = ep0 + 0.00256 * cosOmega;
+	
+	SinCosD(lamda, &sinLamda, &cosLamda);
+	SinCosD(ep0, &sinEp0, &cosEp0);
 
 	/* calculate right ascension and declination */
-	*alpha = Revolution(atan2(CosD(ep0) * SinD(lamda), CosD(lamda)) * kRadDeg);
-	*delta = asin(SinD(ep0) * SinD(lamda)) * kRadDeg;
+	*alpha = Revolution(atan2(cosEp0 * sinLamda, cosLamda) * kRadDeg);
+	*delta = asin(sinEp0 * sinLamda) * kRadDeg;
+	*lambda = lamda;
+	
+	/* calculate the equation of time */
+	*E = aa_equation_of_time_kernel(L0, sinM, cosM, e, cosEp0);
+}
+
+/*******************************************************************************
+	NAME:
+		aa_solar_record
+		
+	PURPOSE:
+		Computes in one evaluation of the solar theory everything
+		app_solar_coordinates knows of an instant: right ascension,
+		declination, apparent longitude, radius vector, equation of time and
+		the transit at a longitude
+		
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 151-153, ch. 27 formula 27.3 for the equation of time
+			
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day UT, taken as TD for the coordinates unless
+			aa_set_auto_delta_t() is on, as app_solar_coordinates does
+		L (double)
+			longitude in degrees, positive west
+	
+	OUTPUT ARGUMENTS:
+		*record (aaSolarRecord)
+			the quantities, see astroalgo.h
+	 
+	RETURNED VALUE:
+		none
+	 
+	GLOBALS USED:
+		none
+	 
+	FUNCTIONS CALLED:
+		solar_coordinates_T, julian_centuries, ut_to_tt, aa_get_auto_delta_t,
+		revolution_180
+	 
+	NOTES:
+		The equation of time is Smart's formula from the same mean longitude,
+		anomaly, eccentricity and obliquity as the coordinates, within a few
+		seconds of formula 27.1 with the full theory.
+		
+		The transit is the one nearest JD, found from the hour angle of the
+		sun at JD turning at 360 degrees a day.  The equation of time is
+		that of JD, so the transit is off by its change in the meantime,
+		under a second when JD is within an hour of noon and up to about 15
+		seconds half a day away.  Pass the local noon for the best transit.
+	 
+********************************************************************************/
+void aa_solar_record( double JD, double L, aaSolarRecord *record)
+{
+	double	H;		/* local hour angle of the sun */
+	
+	solar_coordinates_T(julian_centuries(aa_get_auto_delta_t() ? ut_to_tt(JD) : JD),
+		&record->alpha, &record->delta, &record->lambda, &record->R, &record->E);
+	
+	/* the mean sun is on the meridian of Greenwich at 12h UT, the true sun E minutes ahead */
+	H = revolution_180(360.0 * (JD - 2451545.0) + record->E / 4.0 - L);
+	record->transit = JD - H / 360.0;
 }
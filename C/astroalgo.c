@@ -26,6 +26,55 @@ const char* aa_version(void)
 	return astroalgo_lib_version;
 }
 
+/* accuracy budget for truncated periodic series, 0 evaluates every term */
+static double	aa_tolerance_arcseconds = 0;
+static double	aa_tolerance_seconds = 0;
+
+/*******************************************************************************
+	NAME:
+		aa_set_tolerance
+		aa_get_tolerance
+		
+	PURPOSE:
+		Sets or returns the default accuracy budget used to truncate the
+		periodic series in nutation(), moonphase() and equinox_solstice()
+		
+	REFERENCES:
+		none
+			
+	INPUT ARGUMENTS:
+		arcseconds (double)
+			error allowed in angles, e.g. 0.1 for 0".1, 0 for the full series
+		seconds (double)
+			error allowed in event times, e.g. 30 for half a minute, 0 for the full series
+
+	OUTPUT ARGUMENTS:
+		*arcseconds, *seconds (double)
+			current budget
+	 
+	RETURNED VALUE:
+		none
+	 
+	FUNCTIONS CALLED:
+		none
+	 	
+	NOTES:
+		The budget is process wide, set it once at start up.  The _tol variants
+		of the functions take a budget per call instead.  Negative values are
+		treated as 0.
+********************************************************************************/
+void aa_set_tolerance(double arcseconds, double seconds)
+{
+	aa_tolerance_arcseconds = ( arcseconds > 0 ) ? arcseconds : 0;
+	aa_tolerance_seconds = ( seconds > 0 ) ? seconds : 0;
+}
+
+void aa_get_tolerance(double *arcseconds, double *seconds)
+{
+	*arcseconds = aa_tolerance_arcseconds;
+	*seconds = aa_tolerance_seconds;
+}
+
 /*******************************************************************************
 	NAME:
 		day_of_week_name
@@ -255,7 +304,7 @@ int day_of_week(double j)
 *	 	none
 *	 
 *	FUNCTIONS CALLED:
-*	 	floor
+*	 	none
 *	 
 *	DATE/PROGRAMMER/NOTE:
 *		02-18-2001	Todd A. Guillory	created
@@ -265,5 +314,5 @@ int day_of_week(double j)
 ********************************************************************************/
 int first_week_day(int y)
 {
-	return (int)( y + floor((y-1)/4) - floor((y-1)/100) + floor((y-1)/400) ) % 7;
+	return ( y + (y-1)/4 - (y-1)/100 + (y-1)/400 ) % 7;
 }
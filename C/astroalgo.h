@@ -1,6 +1,9 @@
 #ifndef _ASTROALGO_H
    #define _ASTROALGO_H
 
+/* C Headers */
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -16,6 +19,56 @@ typedef unsigned short		aaHour;			/* 0-23 */
 typedef unsigned short		aaMinute;		/* 0-59 */
 typedef double				aaSecond;		/* fractional seconds */
 
+/* an instant as whole days and nanoseconds from J2000.0, JD 2451545.0 */
+/* exact to the nanosecond, see julian_to_instant() and instant_add() */
+typedef struct
+{
+	long long	day;			/* days from J2000.0, 12h UT of the day */
+	long long	ns;				/* 0 .. 86399999999999 nanoseconds into the day */
+} aaInstant;
+
+/* everything the _ctx functions share at one instant, filled by epoch_init() */
+typedef struct
+{
+	double		JD;				/* Julian Day UT */
+	double		JDE;			/* Julian Ephemeris Day TD */
+	double		T, T2, T3, T4;	/* Julian centuries of JDE from J2000.0 and powers */
+	double		D;				/* mean elongation of the moon, degrees */
+	double		M;				/* mean anomaly of the sun */
+	double		Mprime;			/* mean anomaly of the moon */
+	double		F;				/* moon's argument of latitude */
+	double		omega;			/* longitude of the moon's ascending node */
+	double		deltaPsi;		/* nutation in longitude, arc seconds */
+	double		deltaEpsilon;	/* nutation in obliquity, arc seconds */
+	double		epsilon;		/* true obliquity of the ecliptic, degrees */
+	double		epsilonNull;	/* mean obliquity of the ecliptic */
+	double		theta0;			/* mean sidereal time at Greenwich, degrees */
+	double		theta;			/* apparent sidereal time at Greenwich */
+} aaEpoch;
+
+/* a site and its horizon with the trig computed once, filled by observer_init() */
+typedef struct
+{
+	double		L;				/* longitude, degrees positive west */
+	double		phi;			/* latitude, degrees */
+	double		elevation;		/* height above the horizon seen, meters */
+	double		h0;				/* standard altitude of rising and setting, degrees */
+	double		horizon;		/* h0 lowered by the dip of the horizon */
+	double		sinPhi, cosPhi;
+	double		sinHorizon;
+} aaObserver;
+
+/* what one evaluation of the solar theory gives, filled by aa_solar_record() */
+typedef struct
+{
+	double		alpha;			/* apparent right ascension, degrees */
+	double		delta;			/* apparent declination, degrees */
+	double		lambda;			/* apparent longitude, degrees */
+	double		R;				/* radius vector, AU */
+	double		E;				/* equation of time, minutes of apparent less mean time */
+	double		transit;		/* Julian Day UT of the transit nearest JD */
+} aaSolarRecord;
+
 /* Type Definitions */
 typedef char				DOWi;		/* day of week index 0=Sunday..6=Saturday */
 
@@ -28,6 +81,69 @@ typedef enum moonphases
 	lastquarter = 3
 } Moonphases;
 
+/* whether a body rises and sets on a day, see rise_tran_set_calendar() */
+typedef enum risesetstates
+{
+	rs_always_below = 0,		/* below the horizon all day, polar night for the sun */
+	rs_rises_sets = 1,
+	rs_always_above = 2			/* above the horizon all day, polar day */
+} RiseSetStates;
+
+/* nutation series used by nutation() and everything built on it */
+typedef enum nutationmodels
+{
+	nutation_meeus = 0,			/* 63 term subset of IAU 1980, Meeus ch. 21 (default) */
+	nutation_iau2000b = 1,		/* 77 luni-solar terms of IAU 2000B, about 1 mas */
+	nutation_custom = 2			/* caller supplied table, see nutation_set_table() */
+} NutationModels;
+
+/* instruction set used by the batch kernels, see aa_set_isa() */
+typedef enum isalevels
+{
+	isa_scalar = 0,				/* loops over the scalar functions, the reference */
+	isa_sse2 = 1,				/* baseline build of the kernels, SSE2 on x86-64 */
+	isa_avx2 = 2,
+	isa_avx512 = 3
+} IsaLevels;
+
+/* quantities of a Chebyshev ephemeris file, see ephemeris_compile() */
+typedef enum ephemerisquantities
+{
+	eph_alpha = 0,				/* apparent right ascension of the sun, degrees */
+	eph_delta = 1,				/* apparent declination of the sun, degrees */
+	eph_R = 2,					/* radius vector of the sun, AU */
+	eph_delta_psi = 3,			/* nutation in longitude, arc seconds */
+	eph_delta_epsilon = 4,		/* nutation in obliquity, arc seconds */
+	eph_illumination = 5,		/* illuminated fraction of the moon's disc */
+	eph_count = 6
+} EphemerisQuantities;
+
+/* one periodic term of a nutation series in IAU 2000 form */
+/* argument = arg[0]*l + arg[1]*l' + arg[2]*F + arg[3]*D + arg[4]*omega */
+/* coefficients in units of 0.1 microarcseconds for caller supplied tables */
+typedef struct
+{
+	signed char	arg[5];		/* multiples of l (M'), l' (M), F, D and omega */
+	double		ps, pst;	/* longitude: sin(argument) and T * sin(argument) */
+	double		ec, ect;	/* obliquity: cos(argument) and T * cos(argument) */
+	double		pc, es;		/* longitude cos(argument), obliquity sin(argument) */
+} aaNutationTerm;
+
+
+/* an ephemeris file mapped by ephemeris_open(), read only once open */
+typedef struct
+{
+	const double	*data;			/* first segment */
+	double			JD;				/* first Julian Day TD covered */
+	double			span;			/* days per segment */
+	int				segments;
+	int				coefficients;	/* per quantity and segment */
+	int				stride;			/* doubles from one segment to the next */
+	NutationModels	model;			/* nutation model the file was compiled with */
+	double			tolerance;		/* and the aa_set_tolerance angle tolerance */
+	void			*map;			/* the mapping, or the memory it was read into */
+	size_t			size;			/* bytes of map */
+} aaEphemeris;
 			
 /* Function Declarations */
 
@@ -47,34 +163,163 @@ int date_to_julian(short inMonth, double inDay, int inYear, double *JD);
 
 int julian_to_date(double JD, short* month, double* day, int* year);
 
+int date_to_julian_n(const short *month, const double *day, const int *year, double *JD, int n);
+
+int julian_to_date_n(const double *JD, short *month, double *day, int *year, int n);
+
+int timestamp_to_julian(const char *text, size_t length, double *JD);
+
+int timestamps_to_julian(const char *text, size_t length, int final, double *JD, int maxJD, size_t *consumed);
+
+aaInstant julian_to_instant(double JD);
+
+double instant_to_julian(aaInstant t);
+
+aaInstant unix_to_instant(long long seconds, long nanoseconds);
+
+aaInstant instant_add(aaInstant t, long long days, long long ns);
+
+long long instant_diff(aaInstant a, aaInstant b);
+
+double instant_centuries(aaInstant t);
+
+double delta_t(double JD);
+
+double ut_to_tt(double JD);
+
+double tt_to_ut(double JDE);
+
+void epoch_init(aaEpoch *epoch, double JD);
+
+void epoch_init_instant(aaEpoch *epoch, aaInstant t);
+
+void observer_init(aaObserver *observer, double L, double phi, double elevation, double h0);
+
 double zero_hour_julian(double JD);
 
 double mean_sidereal_time(double JD);
 
 double app_sidereal_time(double JD);
 
+double mean_sidereal_time_instant(aaInstant t);
+
+double app_sidereal_time_instant(aaInstant t);
+
 void app_solar_coordinates( double JD, double *alpha, double *delta);
 
+void app_solar_coordinates_instant( aaInstant t, double *alpha, double *delta);
+
+void app_solar_coordinates_ctx( const aaEpoch *epoch, double *alpha, double *delta);
+
+void app_solar_coordinates_n(const double *JD, double *alpha, double *delta, double *lambda, double *R, int n);
+
+void app_solar_coordinates_grid(double JD, double step, int n, double *alpha, double *delta, double *lambda, double *R);
+
+void aa_solar_record( double JD, double L, aaSolarRecord *record);
+
+void apparent_solar_time_n(const double *JD, double L, double *t, double *E, int n);
+
+int solar_geometry_grid(double JD, double step, int nt,
+	const double *L, const double *phi, const double *tilt, const double *gamma, int ns,
+	double *zenith, double *A, double *cosIncidence, double *E0);
+
 int rise_tran_set(double L, double phi, double h0, double JD, double A[], double D[], double m[]);
 
+int rise_tran_set_obs(const aaObserver *observer, double JD, double A[], double D[], double m[]);
+
+int rise_tran_set_calendar(const aaObserver *observer, double JD, int days, double m[], signed char state[]);
+
+int rise_tran_set_raster(double JD, double h0, double phi0, double dphi, int rows,
+	double L0, double dL, int cols, float rise[], float set[], double transit[], signed char state[]);
+
+int solar_altitude_raster(double JD, double phi0, double dphi, int rows, double L0, double dL, int cols,
+	double h[], double A[]);
+
+int solar_altitude_raster_f(double JD, double phi0, double dphi, int rows, double L0, double dL, int cols,
+	float h[], float A[]);
+
 void azimuth_altitude( double JD, double alpha, double delta, double L, double phi, double *A, double *h);
 
+void azimuth_altitude_instant( aaInstant t, double alpha, double delta, double L, double phi, double *A, double *h);
+
+void azimuth_altitude_ctx( const aaEpoch *epoch, double alpha, double delta, double L, double phi, double *A, double *h);
+
+void azimuth_altitude_obs( const aaObserver *observer, double JD, double alpha, double delta, double *A, double *h);
+
+void azimuth_altitude_obs_ctx( const aaObserver *observer, const aaEpoch *epoch, double alpha, double delta, double *A, double *h);
+
+void azimuth_altitude_n(double JD, const double *alpha, const double *delta, double L, double phi,
+	double *A, double *h, int n);
+
+void azimuth_altitude_obs_ctx_n(const aaObserver *observer, const aaEpoch *epoch,
+	const double *alpha, const double *delta, double *A, double *h, int n);
+
+double hour_angle( double JD, double L, double alpha );
+
+double hour_angle_obs( const aaObserver *observer, double JD, double alpha );
+
 void nutation( double T, double *deltaPsi, double *deltaEpsilon);
 
+void nutation_tol( double T, double tolerance, double *deltaPsi, double *deltaEpsilon);
+
+int nutation_set_model( NutationModels model );
+
+NutationModels nutation_get_model( void );
+
+int nutation_set_table( const aaNutationTerm *terms, int count );
+
 void obliquity( double T, double *epsilon, double *epsilonNull);
 
 double moonphase( double year, Moonphases phase );
 
+double moonphase_tol( double year, Moonphases phase, double tolerance );
+
 double equinox_solstice( double inYear, unsigned short inES );
 
+double equinox_solstice_tol( double inYear, unsigned short inES, double tolerance );
+
 double aeaster(int year);
 
 double simple_illumination( double inJulian );
 
+double simple_illumination_ctx( const aaEpoch *epoch );
+
+int ephemeris_compile(const char *path, double JD, double days, double span, int degree);
+
+int ephemeris_open(aaEphemeris *ephemeris, const char *path);
+
+void ephemeris_close(aaEphemeris *ephemeris);
+
+int ephemeris_value(const aaEphemeris *ephemeris, double JD, EphemerisQuantities quantity, double *value);
+
+void ephemeris_solar_coordinates(const aaEphemeris *ephemeris, double JD, double *alpha, double *delta);
+
+void ephemeris_nutation(const aaEphemeris *ephemeris, double T, double *deltaPsi, double *deltaEpsilon);
+
+double ephemeris_illumination(const aaEphemeris *ephemeris, double JD);
+
 int day_of_week_index(int day, int month, int year);
 
 const char* aa_version(void);
 
+void aa_set_tolerance(double arcseconds, double seconds);
+
+void aa_get_tolerance(double *arcseconds, double *seconds);
+
+void aa_set_auto_delta_t(int apply);
+
+int aa_get_auto_delta_t(void);
+
+IsaLevels aa_get_isa(void);
+
+int aa_set_isa(IsaLevels level);
+
+int aa_isa_supported(IsaLevels level);
+
+int aa_get_threads(void);
+
+int aa_set_threads(int count);
+
 #ifdef __cplusplus
 }
 #endif
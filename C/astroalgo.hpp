@@ -0,0 +1,595 @@
+#ifndef _ASTROALGO_HPP
+   #define _ASTROALGO_HPP
+
+/* header-only C++ interface to the library, namespace astroalgo */
+/* the small helpers are defined inline here so they inline into the caller, */
+/* the series evaluations with their tables stay in the C library */
+/* requires C++11 */
+
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astroprecision.hpp"
+
+/* C++ Headers */
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace astroalgo
+{
+
+/* calendar date, month 1-12, fractional day */
+struct date
+{
+	int		year;
+	short	month;
+	double	day;
+};
+
+/* hours or degrees, minutes and seconds */
+struct sexagesimal
+{
+	short	whole;
+	short	minute;
+	double	second;
+};
+
+/* nutation in longitude and obliquity in arc seconds */
+struct nutation_angles
+{
+	double	deltaPsi;
+	double	deltaEpsilon;
+};
+
+/* true and mean obliquity of the ecliptic in degrees */
+struct obliquity_angles
+{
+	double	epsilon;
+	double	epsilonNull;
+};
+
+/* transit, rising and setting as fractions of the day, valid false if the */
+/* body stays above or below the horizon all day */
+struct rise_transit_set
+{
+	bool	valid;
+	double	transit;
+	double	rise;
+	double	set;
+};
+
+/*******************************************************************************
+	NAME:
+		julian_centuries
+		zero_hour_julian
+		mean_sidereal_time
+		app_sidereal_time
+
+	PURPOSE:
+		Time helpers, see the C functions of the same names
+
+********************************************************************************/
+constexpr double julian_centuries(double JDe)
+{
+	return ( JDe - 2451545.0 ) / 36525.0;
+}
+
+inline double zero_hour_julian(double JD)
+{
+	return std::floor(JD - 0.5) + 0.5;
+}
+
+inline double mean_sidereal_time(double JD)
+{
+	const double	T = julian_centuries(JD);
+
+	return revolution(280.46061837 + 360.98564736629 * (JD - 2451545.0) + 0.000387933 * T * T - (T * T * T) / 38710000.0);
+}
+
+inline double app_sidereal_time(double JD)
+{
+	return ::app_sidereal_time(JD);
+}
+
+/* TD - UT in seconds and conversions between the two, see delta_t */
+inline double delta_t(double JD)
+{
+	return ::delta_t(JD);
+}
+
+inline double ut_to_tt(double JD)
+{
+	return ::ut_to_tt(JD);
+}
+
+inline double tt_to_ut(double JDE)
+{
+	return ::tt_to_ut(JDE);
+}
+
+/* the quantities of one instant shared by the aaEpoch overloads below */
+inline aaEpoch epoch(double JD)
+{
+	aaEpoch		result;
+
+	::epoch_init(&result, JD);
+	return result;
+}
+
+inline aaEpoch epoch(const aaInstant &t)
+{
+	aaEpoch		result;
+
+	::epoch_init_instant(&result, t);
+	return result;
+}
+
+/* the same for an instant, see instant_centuries and the _instant C functions */
+inline double julian_centuries(const aaInstant &t)
+{
+	return ::instant_centuries(t);
+}
+
+inline double mean_sidereal_time(const aaInstant &t)
+{
+	return ::mean_sidereal_time_instant(t);
+}
+
+inline double app_sidereal_time(const aaInstant &t)
+{
+	return ::app_sidereal_time_instant(t);
+}
+
+/* integer calendar arithmetic shared by the constexpr functions, C++11 */
+/* constexpr allows a single return statement so each step is a function */
+namespace detail
+{
+
+constexpr long long floor_div(long long a, long long b)
+{
+	return a / b - ( a % b < 0 ? 1 : 0 );
+}
+
+/* January and February count as months 13 and 14 of the year before */
+constexpr long long march_year(int month, int year)
+{
+	return ( month <= 2 ) ? year - 1 : year;
+}
+
+constexpr long long march_month(int month)
+{
+	return ( month <= 2 ) ? month + 12 : month;
+}
+
+/* INT(365.25 (Y + 4716)) + INT(30.6001 (M + 1)), see aa_calendar_days */
+constexpr long long calendar_days(int month, int year)
+{
+	return floor_div(1461 * (march_year(month, year) + 4716), 4) + (306001 * (march_month(month) + 1)) / 10000;
+}
+
+/* B = 2 - A + INT(A / 4), A = INT(Y / 100) */
+constexpr long long gregorian_days(int month, int year)
+{
+	return 2 - march_year(month, year) / 100 + (march_year(month, year) / 100) / 4;
+}
+
+constexpr bool julian_calendar(int month, double day, int year)
+{
+	return year < 1582 || (year == 1582 && (month < 10 || (month == 10 && day < 5)));
+}
+
+constexpr bool reform_gap(int month, double day, int year)
+{
+	return year == 1582 && month == 10 && day >= 5 && day < 15;
+}
+
+constexpr int day_of_week_sum(int d, int m, int y)
+{
+	return ((13 * m - 1) / 5) + d + (y % 100) + ((y % 100) / 4) + ((y / 100) / 4) - 2 * (y / 100) + 77;
+}
+
+template <int... I> struct index_list {};
+
+template <int N, int... I> struct make_index_list : make_index_list<N - 1, N - 1, I...> {};
+
+template <int... I> struct make_index_list<0, I...>
+{
+	typedef index_list<I...> type;
+};
+
+template <typename Fn, int... I>
+constexpr std::array<decltype(Fn()(0)), sizeof...(I)> year_table(Fn fn, int firstYear, index_list<I...>)
+{
+	return {{ fn(firstYear + I)... }};
+}
+
+} /* namespace detail */
+
+/*******************************************************************************
+	NAME:
+		leap_year
+		day_of_week
+		first_week_day
+		day_of_week_index
+		date_to_julian
+		julian_to_date
+
+	PURPOSE:
+		Calendar functions, see the C functions of the same names
+
+	NOTES:
+		All but day_of_week and julian_to_date are constexpr and integer
+		only, date_to_julian gives bit for bit the double the C function
+		gives, for |year| < 1,000,000.
+
+		date_to_julian returns NaN for the dates dropped by the Gregorian
+		reform, 10/5/1582 - 10/14/1582, where the C function returns 0.
+		julian_to_date returns month 0 where the C function returns 0.
+
+********************************************************************************/
+constexpr int leap_year(int y)
+{
+	return ( y >= 0 ) ? (( y % 400 == 0 || (y % 4 == 0 && y % 100 != 0) ) ? 29 : 28)
+					  : (( y % 4 == 0 ) ? 29 : 28);
+}
+
+inline int day_of_week(double j)
+{
+	return (int)(zero_hour_julian(j) + 1.5) % 7;
+}
+
+constexpr int first_week_day(int y)
+{
+	return ( y + (y - 1) / 4 - (y - 1) / 100 + (y - 1) / 400 ) % 7;
+}
+
+constexpr int day_of_week_index(int d, int m, int y)
+{
+	return detail::day_of_week_sum(d, ( m > 2 ) ? m - 2 : m + 10, ( m > 2 ) ? y : y - 1) % 7;
+}
+
+constexpr double date_to_julian(int month, double day, int year)
+{
+	return detail::reform_gap(month, day, year) ? std::numeric_limits<double>::quiet_NaN()
+		: double(detail::calendar_days(month, year)) + day
+			+ double(detail::julian_calendar(month, day, year) ? 0 : detail::gregorian_days(month, year)) - 1524.5;
+}
+
+/*******************************************************************************
+	NAME:
+		year_table
+		new_year_table
+
+	PURPOSE:
+		Tables with one entry per year built at compile time
+
+	INPUT ARGUMENTS:
+		FirstYear, Count (int template arguments)
+			years FirstYear .. FirstYear + Count - 1
+		fn
+			constexpr function object taking the year as int
+
+	RETURNED VALUE:
+		std::array of fn(year), or of the Julian Day of January 1 0h
+
+	NOTES:
+		static constexpr auto jan1 = astroalgo::new_year_table<1900, 201>();
+		puts the table in read only data with no start up cost.
+
+********************************************************************************/
+template <int FirstYear, int Count, typename Fn>
+constexpr std::array<decltype(Fn()(0)), Count> year_table(Fn fn)
+{
+	return detail::year_table(fn, FirstYear, typename detail::make_index_list<Count>::type());
+}
+
+struct new_year_julian_day
+{
+	constexpr double operator()(int year) const
+	{
+		return date_to_julian(1, 1.0, year);
+	}
+};
+
+template <int FirstYear, int Count>
+constexpr std::array<double, Count> new_year_table()
+{
+	return year_table<FirstYear, Count>(new_year_julian_day());
+}
+
+inline date julian_to_date(double JD)
+{
+	const double	J = JD + 0.5;
+	const double	Z = std::floor(J);
+	const double	F = J - Z;
+	double			A, B, C, D, E, alpha;
+	date			result;
+
+	if ( Z >= 2299161 )
+	{
+		alpha = std::floor( (Z - 1867216.25) / 36524.25 );
+		A = Z + 1 + alpha - std::floor(alpha / 4);
+	}
+	else
+		A = Z;
+
+	B = A + 1524;
+	C = std::floor( (B - 122.1) / 365.25 );
+	D = std::floor( 365.25 * C );
+	E = std::floor( (B - D) / 30.6001 );
+
+	result.day = B - D - std::floor(30.6001 * E) + F;
+
+	if ( E < 14 )
+		result.month = (short)(E - 1.0);
+	else if ( E == 14 || E == 15 )
+		result.month = (short)(E - 13.0);
+	else
+		result.month = 0;
+
+	result.year = (int)(C - (( result.month > 2 ) ? 4716.0 : 4715.0));
+
+	return result;
+}
+
+/*******************************************************************************
+	NAME:
+		revolution_180
+		normalize_0_to_1
+		fraction_to_time
+		angle_to_time
+
+	PURPOSE:
+		Reductions and conversions, see revolution_180, Normalize0To1,
+		Fraction2Time and Angle2Time.  sin_d, cos_d, tan_d, sincos_d and
+		revolution come from astroprecision.hpp.
+
+********************************************************************************/
+inline double revolution_180(double theta)
+{
+	if ( theta >= -180.0 && theta <= 180.0 )
+		return theta;
+
+	theta = std::fmod(theta, 360.0);
+
+	if ( theta > 180.0 )
+		theta -= 360.0;
+	else if ( theta < -180.0 )
+		theta += 360.0;
+
+	return theta;
+}
+
+inline double normalize_0_to_1(double x)
+{
+	double	f;
+
+	if ( x >= 0.0 && x <= 1.0 )
+		return x;
+
+	f = x - std::floor(x);
+
+	return ( x > 1.0 && f == 0.0 ) ? 1.0 : f;
+}
+
+inline sexagesimal fraction_to_time(double x)
+{
+	const double	i = x - std::floor(x);
+	sexagesimal		result;
+
+	result.whole = (short)(i * 24);
+	result.minute = (short)((i * 24 - result.whole) * 60);
+	result.second = ((i * 24 - result.whole) * 60 - result.minute) * 60;
+
+	return result;
+}
+
+inline sexagesimal angle_to_time(double x)
+{
+	const double	f = (x / 15 - std::floor(x / 15)) * 60;
+	sexagesimal		result;
+
+	result.whole = (short)(x / 15);
+	result.minute = (short)f;
+	result.second = (f - std::floor(f)) * 60;
+
+	return result;
+}
+
+/*******************************************************************************
+	NAME:
+		app_solar_coordinates
+		simple_illumination
+
+	PURPOSE:
+		Double precision instantiations of the templates in astroprecision.hpp,
+		azimuth_altitude deduces double from its arguments.  The aaInstant
+		overloads take the sidereal time from app_sidereal_time_instant,
+		the aaEpoch ones everything they can from the epoch.
+
+		app_solar_coordinates and simple_illumination take JD at UT when
+		aa_set_auto_delta_t() is on, as the C functions and the templates do.
+
+********************************************************************************/
+inline equatorial<double> app_solar_coordinates(double JD)
+{
+	return app_solar_coordinates<double>(JD);
+}
+
+inline equatorial<double> app_solar_coordinates(const aaInstant &t)
+{
+	equatorial<double>	result;
+
+	::app_solar_coordinates_instant(t, &result.alpha, &result.delta);
+	return result;
+}
+
+inline equatorial<double> app_solar_coordinates(const aaEpoch &epoch)
+{
+	equatorial<double>	result;
+
+	::app_solar_coordinates_ctx(&epoch, &result.alpha, &result.delta);
+	return result;
+}
+
+/* coordinates, radius vector, equation of time and transit at once, see aa_solar_record */
+inline aaSolarRecord solar_record(double JD, double L)
+{
+	aaSolarRecord	result;
+
+	::aa_solar_record(JD, L, &result);
+	return result;
+}
+
+template <typename Real>
+inline horizontal<Real> azimuth_altitude(const aaEpoch &epoch, Real alpha, Real delta, Real L, Real phi)
+{
+	return azimuth_altitude_sidereal<Real>(epoch.theta, alpha, delta, L, phi);
+}
+
+template <typename Real>
+inline horizontal<Real> azimuth_altitude(const aaInstant &t, Real alpha, Real delta, Real L, Real phi)
+{
+	return azimuth_altitude_sidereal<Real>(::app_sidereal_time_instant(t), alpha, delta, L, phi);
+}
+
+/* site trig from the observer, see observer_init */
+inline aaObserver observer(double L, double phi, double elevation, double h0)
+{
+	aaObserver	result;
+
+	::observer_init(&result, L, phi, elevation, h0);
+	return result;
+}
+
+inline horizontal<double> azimuth_altitude(const aaObserver &site, double JD, double alpha, double delta)
+{
+	horizontal<double>	result;
+
+	::azimuth_altitude_obs(&site, JD, alpha, delta, &result.A, &result.h);
+	return result;
+}
+
+inline horizontal<double> azimuth_altitude(const aaObserver &site, const aaEpoch &epoch, double alpha, double delta)
+{
+	horizontal<double>	result;
+
+	::azimuth_altitude_obs_ctx(&site, &epoch, alpha, delta, &result.A, &result.h);
+	return result;
+}
+
+inline double hour_angle(double JD, double L, double alpha)
+{
+	return ::hour_angle(JD, L, alpha);
+}
+
+inline double hour_angle(const aaObserver &site, double JD, double alpha)
+{
+	return ::hour_angle_obs(&site, JD, alpha);
+}
+
+inline double simple_illumination(double JD)
+{
+	return simple_illumination<double>(JD);
+}
+
+inline double simple_illumination(const aaEpoch &epoch)
+{
+	return ::simple_illumination_ctx(&epoch);
+}
+
+/*******************************************************************************
+	NAME:
+		rise_tran_set
+		nutation
+		obliquity
+		moonphase
+		equinox_solstice
+		easter
+
+	PURPOSE:
+		Value returning forms of the series evaluations in the C library
+
+********************************************************************************/
+inline rise_transit_set rise_tran_set(double L, double phi, double h0, double JD, const double A[3], const double D[3])
+{
+	double				a[3] = { A[0], A[1], A[2] };
+	double				d[3] = { D[0], D[1], D[2] };
+	double				m[3] = { 0, 0, 0 };
+	rise_transit_set	result;
+
+	result.valid = ::rise_tran_set(L, phi, h0, JD, a, d, m) != 0;
+	result.transit = m[0];
+	result.rise = m[1];
+	result.set = m[2];
+
+	return result;
+}
+
+inline rise_transit_set rise_tran_set(const aaObserver &site, double JD, const double A[3], const double D[3])
+{
+	double				a[3] = { A[0], A[1], A[2] };
+	double				d[3] = { D[0], D[1], D[2] };
+	double				m[3] = { 0, 0, 0 };
+	rise_transit_set	result;
+
+	result.valid = ::rise_tran_set_obs(&site, JD, a, d, m) != 0;
+	result.transit = m[0];
+	result.rise = m[1];
+	result.set = m[2];
+
+	return result;
+}
+
+inline nutation_angles nutation(double T)
+{
+	nutation_angles		result;
+
+	::nutation(T, &result.deltaPsi, &result.deltaEpsilon);
+	return result;
+}
+
+inline nutation_angles nutation_tol(double T, double tolerance)
+{
+	nutation_angles		result;
+
+	::nutation_tol(T, tolerance, &result.deltaPsi, &result.deltaEpsilon);
+	return result;
+}
+
+inline obliquity_angles obliquity(double T)
+{
+	obliquity_angles	result;
+
+	::obliquity(T, &result.epsilon, &result.epsilonNull);
+	return result;
+}
+
+inline double moonphase(double year, Moonphases phase)
+{
+	return ::moonphase(year, phase);
+}
+
+inline double moonphase(double year, Moonphases phase, double tolerance)
+{
+	return ::moonphase_tol(year, phase, tolerance);
+}
+
+inline double equinox_solstice(double year, unsigned short es)
+{
+	return ::equinox_solstice(year, es);
+}
+
+inline double equinox_solstice(double year, unsigned short es, double tolerance)
+{
+	return ::equinox_solstice_tol(year, es, tolerance);
+}
+
+inline double easter(int year)
+{
+	return ::aeaster(year);
+}
+
+} /* namespace astroalgo */
+
+#endif /* _ASTROALGO_HPP */
@@ -0,0 +1,434 @@
+#ifndef _ASTROINTERNAL_H
+   #define _ASTROINTERNAL_H
+
+/* declarations shared between the library sources, not part of the public API */
+
+#include "astromath.h"
+
+/* C Headers */
+#include <math.h>
+#include <string.h>
+
+/* thread local storage class, left undefined when the compiler has none */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+	#define AA_THREAD_LOCAL		_Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+	#define AA_THREAD_LOCAL		__thread
+#elif defined(_MSC_VER)
+	#define AA_THREAD_LOCAL		__declspec(thread)
+#endif
+
+/* x86 batch kernels are also built for AVX2 and AVX-512 and picked at run time */
+#if !defined(AA_NO_ISA_DISPATCH) && (defined(__GNUC__) || defined(__clang__)) && \
+	(defined(__x86_64__) || defined(__i386__))
+	#define AA_ISA_DISPATCH		1
+	/* AVX-512 brings FMA, contraction stays off so every level rounds the same */
+	/* clang ignores optimize(), the kernel files use the STDC pragma for it */
+	#define AA_TARGET_AVX2		__attribute__((target("avx2")))
+	#if defined(__clang__)
+		#define AA_TARGET_AVX512	__attribute__((target("avx512f")))
+	#else
+		#define AA_TARGET_AVX512	__attribute__((target("avx512f"), optimize("fp-contract=off")))
+	#endif
+#else
+	#define AA_ISA_DISPATCH		0
+#endif
+
+/* batch kernels are written once in a *_kernels.h file that batchisa.h includes */
+/* for each instruction set, BATCH_NAME(f) names them f_sse2, f_avx2, f_avx512 */
+#define BATCH_CAT2(f, isa)		f##_##isa
+#define BATCH_CAT(f, isa)		BATCH_CAT2(f, isa)
+#define BATCH_NAME(f)			BATCH_CAT(f, BATCH_ISA)
+
+/* dispatch table initializers indexed by IsaLevels, BATCH_FUNCTIONS for a table */
+/* of the kernels f_scalar to f_avx512, BATCH_TABLE for a table of structs with */
+/* row(isa) the entry of one instruction set, levels not built use sse2 */
+#if AA_ISA_DISPATCH
+	#define BATCH_FUNCTIONS(f)		{ f##_scalar, f##_sse2, f##_avx2, f##_avx512 }
+	#define BATCH_TABLE(scalar, row)	{ scalar, row(sse2), row(avx2), row(avx512) }
+#else
+	#define BATCH_FUNCTIONS(f)		{ f##_scalar, f##_sse2, f##_sse2, f##_sse2 }
+	#define BATCH_TABLE(scalar, row)	{ scalar, row(sse2), row(sse2), row(sse2) }
+#endif
+
+/* cells in a chunk of a threaded batch call, enough to outweigh taking it */
+#define AA_PARALLEL_CELLS		16384
+
+/* inline storage class for small helpers defined in this header */
+#if defined(__cplusplus) || (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+	#define AA_INLINE			inline
+#elif defined(__GNUC__) || defined(__clang__)
+	#define AA_INLINE			__inline__
+#elif defined(_MSC_VER)
+	#define AA_INLINE			__inline
+#else
+	#define AA_INLINE
+#endif
+
+/* restrict for the outputs of kernels with more arrays than the vectorizer */
+/* will check for overlap at run time */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L && !defined(__cplusplus)
+	#define AA_RESTRICT			restrict
+#elif defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+	#define AA_RESTRICT			__restrict
+#else
+	#define AA_RESTRICT
+#endif
+
+/* adding and subtracting 1.5 * 2^52 rounds a double to the nearest integer */
+#define TRIG_ROUND			6755399441055744.0
+
+/* minimax coefficients for sin and cos on [-pi/4, pi/4], from fdlibm */
+#define TRIG_S1		-1.66666666666666324348e-01
+#define TRIG_S2		 8.33333333332248946124e-03
+#define TRIG_S3		-1.98412698298579493134e-04
+#define TRIG_S4		 2.75573137070700676789e-06
+#define TRIG_S5		-2.50507602534068634195e-08
+#define TRIG_S6		 1.58969099521155010221e-10
+
+#define TRIG_C1		 4.16666666666666019037e-02
+#define TRIG_C2		-1.38888888888741095749e-03
+#define TRIG_C3		 2.48015872894767294178e-05
+#define TRIG_C4		-2.75573143513906633035e-07
+#define TRIG_C5		 2.08757232129817482790e-09
+#define TRIG_C6		-1.13596475577881948265e-11
+
+/*******************************************************************************
+	NAME:
+		aa_sincosd_kernel
+		
+	PURPOSE:
+		Reduces an angle in degrees to the nearest multiple of 90 and evaluates
+		the sine and cosine of the remainder with polynomials
+		
+	REFERENCES:
+		Sun Microsystems, fdlibm 5.3, k_sin.c and k_cos.c
+			
+	INPUT ARGUMENTS:
+		x (double)
+			input angle in degrees, |x| < 1e15
+	
+	OUTPUT ARGUMENTS:
+	 	*s (double)
+			sine of x
+		*c (double)
+			cosine of x
+	 
+	 RETURNED VALUE:
+	 	none
+	 
+	 GLOBALS USED:
+	 	none
+	 
+	 FUNCTIONS CALLED:
+	 	fabs
+	 	
+	NOTES:
+		x - 90 * q is exact for |x| < 2^53, so multiples of 90 give exact +0
+		and +/-1 and there is no loss from reducing large angles in radians.
+		The zeros are never -0, which would flip the sign of a quotient by
+		the cosine of a latitude or declination of 90 degrees.  No branches
+		or calls, so loops over it vectorize.
+	 
+********************************************************************************/
+static AA_INLINE void aa_sincosd_kernel(double x, double *s, double *c)
+{
+	double	q = (x * (1.0 / 90.0) + TRIG_ROUND) - TRIG_ROUND,	/* nearest multiple of 90 */
+			e = q - 4.0 * ((q * 0.25 + TRIG_ROUND) - TRIG_ROUND),	/* quadrant, -2..2 */
+			z = (x - 90.0 * q) * kDegRad,						/* remainder in radians */
+			z2 = z * z,
+			odd = ( fabs(e) == 1.0 ) ? 1.0 : 0.0,
+			sz, cz;
+	
+	sz = z + z * z2 * (TRIG_S1 + z2 * (TRIG_S2 + z2 * (TRIG_S3 + z2 * (TRIG_S4 + z2 * (TRIG_S5 + z2 * TRIG_S6)))));
+	cz = 1.0 - 0.5 * z2 + z2 * z2 * (TRIG_C1 + z2 * (TRIG_C2 + z2 * (TRIG_C3 + z2 * (TRIG_C4 + z2 * (TRIG_C5 + z2 * TRIG_C6)))));
+	
+	/* rotate by the quadrant, one product of each pair is zero so this is exact */
+	/* and, unlike a select between sz and cz, it vectorizes with trapping math, */
+	/* adding 0 turns the -0 of an exact zero, e.g. the cosine of 90, into +0 */
+	*s = ( odd * cz + (1.0 - odd) * sz ) * ( fabs(e - 0.5) < 1.0 ? 1.0 : -1.0 ) + 0.0;
+	*c = ( odd * sz + (1.0 - odd) * cz ) * ( fabs(e + 0.5) < 1.0 ? 1.0 : -1.0 ) + 0.0;
+}
+
+/* minimax coefficients for atan on [-7/16, 7/16] and atan of the breakpoints */
+/* split in high and low parts, from fdlibm */
+#define ATAN_T0		 3.33333333333329318027e-01
+#define ATAN_T1		-1.99999999998764832476e-01
+#define ATAN_T2		 1.42857142725034663711e-01
+#define ATAN_T3		-1.11111104054623557880e-01
+#define ATAN_T4		 9.09088713343650656196e-02
+#define ATAN_T5		-7.69187620504482999495e-02
+#define ATAN_T6		 6.66107313738753120669e-02
+#define ATAN_T7		-5.83357013379057348645e-02
+#define ATAN_T8		 4.97687799461593236017e-02
+#define ATAN_T9		-3.65315727442169155270e-02
+#define ATAN_T10	 1.62858201153657823623e-02
+
+#define ATAN_HALF_HI	4.63647609000806093515e-01		/* atan(1/2) */
+#define ATAN_HALF_LO	2.26987774529616870924e-17
+#define ATAN_ONE_HI		7.85398163397448278999e-01		/* atan(1) */
+#define ATAN_ONE_LO		3.06161699786838301793e-17
+#define ATAN_PIO2_HI	1.57079632679489655800e+00		/* pi / 2 */
+#define ATAN_PIO2_LO	6.12323399573676603587e-17
+
+/*******************************************************************************
+	NAME:
+		aa_atan2d_kernel
+		aa_revolution_kernel
+		
+	PURPOSE:
+		atan2 in degrees and the reduction of an angle to 0..360 degrees,
+		without branches or calls so loops over them vectorize
+		
+	REFERENCES:
+		Sun Microsystems, fdlibm 5.3, s_atan.c and e_atan2.c
+			
+	INPUT ARGUMENTS:
+		y, x (double)
+			aa_atan2d_kernel: coordinates, not both infinite
+		x (double)
+			aa_revolution_kernel: angle in degrees, |x| < 1e15
+	
+	RETURNED VALUE:
+		aa_atan2d_kernel: angle of (x, y) in degrees, -180..180, 0 for (0, 0)
+		aa_revolution_kernel: x reduced to 0..360 degrees
+	 
+	NOTES:
+		The ratio of the smaller to the larger coordinate is reduced around
+		0, 1/2 or 1 as fdlibm does and the octant restored afterwards, within
+		2 ulp of atan2 from the C library.  The selects are products with 0
+		and 1 as in aa_sincosd_kernel.  asin(s) is atan2(s, sqrt(1 - s * s)).
+		
+		x - 360 * n is exact as in aa_sincosd_kernel, so the reduction gives
+		what Revolution does, but for a negative x within 1e-13 of a multiple
+		of 360 where either may return 360.
+	 
+********************************************************************************/
+static AA_INLINE double aa_atan2d_kernel(double y, double x)
+{
+	double	ax = fabs(x),
+			ay = fabs(y),
+			swap = ( ay > ax ) ? 1.0 : 0.0,						/* above the diagonal */
+			big = swap * ay + (1.0 - swap) * ax,
+			q = (swap * ax + (1.0 - swap) * ay) / ( big + ( big == 0.0 ? 1.0 : 0.0 ) ),
+			half = ( q >= 0.4375 ) ? 1.0 : 0.0,					/* reduce around 1/2 */
+			one = ( q >= 0.6875 ) ? 1.0 : 0.0,					/* reduce around 1 */
+			c = 0.5 * (half + one),
+			z = (q - c) / (1.0 + q * c),
+			hi = (half - one) * ATAN_HALF_HI + one * ATAN_ONE_HI,
+			lo = (half - one) * ATAN_HALF_LO + one * ATAN_ONE_LO,
+			w = z * z,
+			w2 = w * w,
+			s1 = w * (ATAN_T0 + w2 * (ATAN_T2 + w2 * (ATAN_T4 + w2 * (ATAN_T6 + w2 * (ATAN_T8 + w2 * ATAN_T10))))),
+			s2 = w2 * (ATAN_T1 + w2 * (ATAN_T3 + w2 * (ATAN_T5 + w2 * (ATAN_T7 + w2 * ATAN_T9)))),
+			a = hi - ((z * (s1 + s2) - lo) - z),				/* atan(q), 0..pi/4 */
+			left = ( x < 0.0 ) ? 1.0 : 0.0;
+	
+	/* pi/2 - a above the diagonal, then pi - a left of the y axis */
+	a = swap * ((ATAN_PIO2_HI - a) + ATAN_PIO2_LO) + (1.0 - swap) * a;
+	a = left * ((2.0 * ATAN_PIO2_HI - a) + 2.0 * ATAN_PIO2_LO) + (1.0 - left) * a;
+	
+	return a * kRadDeg * ( ( y < 0.0 ) ? -1.0 : 1.0 );
+}
+
+static AA_INLINE double aa_revolution_kernel(double x)
+{
+	double	r = x - 360.0 * ((x * (1.0 / 360.0) + TRIG_ROUND) - TRIG_ROUND);	/* -180..180 */
+	
+	return r + ( ( r < 0.0 ) ? 360.0 : 0.0 );
+}
+
+/* first guess of 1 / sqrt(x) from the bit pattern of x, within 3.5 percent */
+#define SQRT_MAGIC			0x5fe6eb50c7b537a9ULL
+
+/*******************************************************************************
+	NAME:
+		aa_sqrt_kernel
+		
+	PURPOSE:
+		Square root without the errno check of the C library, which keeps
+		loops over sqrt from vectorizing
+		
+	REFERENCES:
+		Lomont, Chris. "Fast Inverse Square Root." Purdue University. 2003.
+			for the first guess
+			
+	INPUT ARGUMENTS:
+		x (double)
+			0 or a normal positive number
+	
+	RETURNED VALUE:
+		square root of x, within 1 ulp of sqrt
+	 
+	NOTES:
+		Three Newton steps for 1 / sqrt(x) from the guess take the error
+		to 3e-11, and one step for sqrt(x) itself finishes it.  There is no
+		division, and 0 gives 0 since the guess stays finite.
+	 
+********************************************************************************/
+static AA_INLINE double aa_sqrt_kernel(double x)
+{
+	unsigned long long	i;
+	double				y, s;
+	
+	memcpy(&i, &x, sizeof i);
+	i = SQRT_MAGIC - (i >> 1);
+	memcpy(&y, &i, sizeof y);
+	
+	y = y * (1.5 - 0.5 * x * y * y);
+	y = y * (1.5 - 0.5 * x * y * y);
+	y = y * (1.5 - 0.5 * x * y * y);
+	s = x * y;
+	
+	return s + 0.5 * y * (x - s * s);
+}
+
+/* rational approximation of (asin(x) - x) / x^3 on [0, 1/4] in x^2, from fdlibm */
+#define ASIN_P0		 1.66666666666666657415e-01
+#define ASIN_P1		-3.25565818622400915405e-01
+#define ASIN_P2		 2.01212532134862925881e-01
+#define ASIN_P3		-4.00555345006794114027e-02
+#define ASIN_P4		 7.91534994289814532176e-04
+#define ASIN_P5		 3.47933107596021167570e-05
+#define ASIN_Q1		-2.40339491173441421878e+00
+#define ASIN_Q2		 2.02094576023350569471e+00
+#define ASIN_Q3		-6.88283971605453293030e-01
+#define ASIN_Q4		 7.70381505559019352791e-02
+
+/*******************************************************************************
+	NAME:
+		aa_asind_kernel
+		
+	PURPOSE:
+		asin in degrees without branches or calls so loops over it vectorize
+		
+	REFERENCES:
+		Sun Microsystems, fdlibm 5.3, e_asin.c
+			
+	INPUT ARGUMENTS:
+		x (double)
+			sine, -1..1
+	
+	RETURNED VALUE:
+		asin(x) in degrees, -90..90
+	 
+	NOTES:
+		Below 1/2 the rational function is used on x, above it on
+		sqrt((1 - |x|) / 2) with asin(x) = pi/2 - 2 asin(sqrt((1 - |x|) / 2)),
+		both computed and the one wanted kept with products as in
+		aa_sincosd_kernel.  The test against 1/2 is a rounding, as GCC
+		would split a comparison there into branches it cannot vectorize.
+		fdlibm splits the square root in two between 1/2 and 0.975, this
+		does not, and is within 4 ulp of asin from the C library.  1 - |x|
+		is taken as 0 for |x| over 1 from rounding.
+	 
+********************************************************************************/
+static AA_INLINE double aa_asind_kernel(double x)
+{
+	double	ax = fabs(x),
+			big = (ax + TRIG_ROUND) - TRIG_ROUND,				/* 1 above 1/2, else 0 */
+			w = 0.25 * ((1.0 - ax) + fabs(1.0 - ax)),			/* (1 - |x|) / 2, not below 0 */
+			t = big * w + (1.0 - big) * ax * ax,
+			p = t * (ASIN_P0 + t * (ASIN_P1 + t * (ASIN_P2 + t * (ASIN_P3 + t * (ASIN_P4 + t * ASIN_P5))))),
+			q = 1.0 + t * (ASIN_Q1 + t * (ASIN_Q2 + t * (ASIN_Q3 + t * ASIN_Q4))),
+			u = big * aa_sqrt_kernel(t) + (1.0 - big) * ax,
+			a = u + u * (p / q);							/* asin(u) */
+	
+	a = big * (ATAN_PIO2_HI - (2.0 * a - ATAN_PIO2_LO)) + (1.0 - big) * a;
+	
+	return a * kRadDeg * ( ( x < 0.0 ) ? -1.0 : 1.0 );
+}
+
+/* equation of time in minutes, apparent less mean solar time, by Smart's formula */
+/* from the sun's geometric mean longitude L0 in degrees, the sine and cosine of */
+/* its mean anomaly, the eccentricity e of Earth's orbit and the cosine of the */
+/* obliquity, Meeus ch. 27, formula 27.3 */
+static AA_INLINE double aa_equation_of_time_kernel(double L0, double sinM, double cosM, double e, double cosEpsilon)
+{
+	double	y = (1.0 - cosEpsilon) / (1.0 + cosEpsilon),		/* tan^2 (epsilon / 2) */
+			sin2L0, cos2L0;
+	
+	aa_sincosd_kernel(2.0 * L0, &sin2L0, &cos2L0);
+	
+	/* in radians, sin 4L0 and sin 2M from the double angle formulas */
+	return 4.0 * kRadDeg * ( y * sin2L0 - 2.0 * e * sinM + 4.0 * e * y * sinM * cos2L0
+		- y * y * sin2L0 * cos2L0 - 2.5 * e * e * sinM * cosM );
+}
+
+/* floor(a / b) for b > 0, C division truncates toward zero */
+static AA_INLINE long aa_floor_div(long a, long b)
+{
+	return a / b - ( a % b < 0 );
+}
+
+/*******************************************************************************
+	NAME:
+		aa_calendar_days
+		aa_gregorian_days
+		
+	PURPOSE:
+		Integer parts of Meeus 7.1, the Julian Day of a date is
+		aa_calendar_days + day + aa_gregorian_days - 1524.5
+		
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 61
+			
+	INPUT ARGUMENTS:
+		year (long)
+			year, astronomical numbering
+		month (long)
+			month 1-12
+	
+	RETURNED VALUE:
+		aa_calendar_days: INT(365.25 (Y + 4716)) + INT(30.6001 (M + 1)) with
+			January and February counted as months 13 and 14 of the year before
+		aa_gregorian_days: B, 2 - A + INT(A / 4) with A = INT(Y / 100)
+	 	
+	NOTES:
+		Exact integer arithmetic, 30.6001 (M + 1) is never within 1e-3 of an
+		integer for M = 3..14 so 306001 (M + 1) / 10000 gives the same floor.
+		Good for |year| < 1,000,000 with a 32 bit long.
+	 
+********************************************************************************/
+static AA_INLINE long aa_calendar_days(long year, long month)
+{
+	if ( month <= 2 )
+	{
+		--year;
+		month += 12;
+	}
+	
+	return aa_floor_div(1461 * (year + 4716), 4) + (306001 * (month + 1)) / 10000;
+}
+
+static AA_INLINE long aa_gregorian_days(long year, long month)
+{
+	long	A = ( ( month <= 2 ) ? year - 1 : year ) / 100;
+	
+	return 2 - A + A / 4;
+}
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Function Declarations */
+
+void nutation_obliquity( double T, double *deltaPsi, double *deltaEpsilon, double *epsilon, double *epsilonNull);
+
+void solar_coordinates_T( double T, double *alpha, double *delta, double *lambda, double *R, double *E);
+
+double simple_illumination_T( double T );
+
+int rise_tran_set_site(double L, double sinPhi, double cosPhi, double h0, double sinHorizon,
+	double theta0, double deltaT, const double A[], const double D[], double m[]);
+
+void aa_parallel_for(int n, int grain, void (*body)(void *context, int begin, int end), void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ASTROINTERNAL_H */
@@ -1,4 +1,5 @@
 #include "astromath.h"
+#include "astrointernal.h"
 
 /* C Headers */
 #include <math.h>
@@ -50,6 +51,47 @@ double TanD(double x)
 	return tan( x * kDegRad );
 }
 
+/*******************************************************************************
+	NAME:
+		SinCosD
+		
+	PURPOSE:
+		Sine and cosine of the same angle in degrees, computed together
+		
+	REFERENCES:
+		none
+			
+	INPUT ARGUMENTS:
+		x (double)
+			input angle in degrees
+	
+	OUTPUT ARGUMENTS:
+	 	*s (double)
+	 		sine of x
+	 	*c (double)
+	 		cosine of x
+	 
+	 RETURNED VALUE:
+	 	none
+	 
+	 GLOBALS USED:
+	 	none
+	 
+	 FUNCTIONS CALLED:
+	 	fmod, aa_sincosd_kernel
+	 
+	NOTES:
+		The reduction is done in degrees, fmod is exact, so multiples of 90
+		give exact 0 and +/-1 at any magnitude.  One shared reduction and no
+		library calls makes this cheaper than SinD followed by CosD, results
+		agree with them to about 1e-16.
+		
+********************************************************************************/
+void SinCosD(double x, double *s, double *c)
+{
+	aa_sincosd_kernel( fmod(x, 360.0), s, c );
+}
+
 /*******************************************************************************
 	NAME:
 		Normalize0To1
@@ -74,7 +116,7 @@ double TanD(double x)
 	 	none
 	 
 	 FUNCTIONS CALLED:
-	 	fabs
+	 	floor
 	 
 	DATE/PROGRAMMER/NOTE:
 		1-15-2000	Todd A. Guillory	created
@@ -84,20 +126,32 @@ double TanD(double x)
 				x,		0 <= x <= 1
 				x - 1,	x > 1
 				
+		applied until the result is in range, computed directly instead of
+		one step at a time so the cost does not grow with |x|
+				
 		Examples:
 			-0.65 -> 0.35
 			-3.45 -> 0.65
 			+1.25 -> 0.25
+			
+		Edge cases:
+			0 and 1 are returned unchanged
+			whole numbers above 1 give 1, whole numbers below 0 give 0
+			tiny negative values give 1.0 once x + 1 rounds to 1
+			NaN and +/-inf give NaN
 	
 ********************************************************************************/
 double Normalize0To1(double x)
 {
-	while ( x < 0 || x > 1 )
-		if ( x > 1 )
-			--x;
-		else
-			++x;
-	return x;
+	double	f;
+	
+	if ( x >= 0.0 && x <= 1.0 )
+		return x;
+	
+	/* x - floor(x) is exact, inf - inf gives NaN */
+	f = x - floor(x);
+	
+	return ( x > 1.0 && f == 0.0 ) ? 1.0 : f;
 }
 
 /*
@@ -179,24 +233,75 @@ double Revolution(double theta)
 	 
 	 DATE/PROGRAMMER/NOTE:
 	 	4-23-20001	Todd A. Guillory	created
+	 	
+	NOTES:
+		+180 and -180 are both returned unchanged, reduced angles keep the
+		sign of theta at the boundary, so 540 -> 180 and -540 -> -180.  fmod
+		and the single correction are exact.  NaN and +/-inf give NaN.
 		
 ********************************************************************************/
 double revolution_180(double theta)
 {
-	while (theta < -180.0 || theta > 180.0)
-	{
-		theta = fmod(theta, 360.0);
-		if ( theta > 180.0 )
-			theta = theta - 360.0;
-		else if ( theta < -180.0 )
-			theta = theta + 360.0;
-		else
-			;
-	}
+	if ( theta >= -180.0 && theta <= 180.0 )
+		return theta;
+	
+	theta = fmod(theta, 360.0);
+	
+	if ( theta > 180.0 )
+		theta -= 360.0;
+	else if ( theta < -180.0 )
+		theta += 360.0;
 		
 	return theta;
 }
 
+/*******************************************************************************
+	NAME:
+		Normalize0To1_n
+		revolution_180_n
+		
+	PURPOSE:
+		Normalize0To1 and revolution_180 over arrays
+		
+	REFERENCES:
+		none
+			
+	INPUT ARGUMENTS:
+		x[] (double)
+			input values
+		n (int)
+			number of values
+	
+	OUTPUT ARGUMENTS:
+	 	y[] (double)
+	 		normalized values, y may be the same array as x
+		
+	 RETURNED VALUE:
+	 	none
+	 
+	 GLOBALS USED:
+	 	none
+	 
+	 FUNCTIONS CALLED:
+	 	Normalize0To1, revolution_180
+		
+********************************************************************************/
+void Normalize0To1_n(const double *x, double *y, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+		y[i] = Normalize0To1(x[i]);
+}
+
+void revolution_180_n(const double *x, double *y, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+		y[i] = revolution_180(x[i]);
+}
+
 
 /*******************************************************************************
 	NAME:
@@ -29,12 +29,24 @@ double CosD(double x);
 
 double TanD(double x);
 
+void SinCosD(double x, double *s, double *c);
+
+void SinD_n(const double *x, double *y, int n);
+
+void CosD_n(const double *x, double *y, int n);
+
+void SinCosD_n(const double *x, double *s, double *c, int n);
+
 double Normalize0To1(double x);
 
 double Revolution(double theta);
 
 double revolution_180(double theta);
 
+void Normalize0To1_n(const double *x, double *y, int n);
+
+void revolution_180_n(const double *x, double *y, int n);
+
 void Fraction2Time(double x, short *hour, short *minute, double *second);
 
 void Angle2Time(double x, short *degree, short *minute, double *second);
@@ -0,0 +1,400 @@
+#ifndef _ASTROPRECISION_HPP
+   #define _ASTROPRECISION_HPP
+
+/* precision policy templates for the solar, horizontal and illumination routines */
+/* instantiate with float for bulk rendering work, double matches the C library */
+/* requires C++11 */
+
+#include "astroalgo.h"
+
+/* C++ Headers */
+#include <cmath>
+
+namespace astroalgo
+{
+
+/*******************************************************************************
+	NAME:
+		precision
+
+	PURPOSE:
+		Precision policy, the real type the angles are computed in together
+		with its trig polynomial and the measured error bounds of the
+		routines in this header
+
+	REFERENCES:
+		Sun Microsystems, fdlibm 5.3, k_sin.c and k_cos.c (double)
+		Moshier, Stephen L. Cephes Math Library, sinf.c (float)
+
+	NOTES:
+		Error bounds are the largest differences seen against long double
+		evaluations of the same formulas, 1900 to 2100 every 0.37 days, all
+		latitudes, in degrees (fraction for the illumination).  They measure
+		the rounding of the chosen type only, not the accuracy of the
+		formulas, which is 0.01 degrees for the sun, Meeus ch. 24.
+
+		Time dependent arguments are always evaluated in double and reduced
+		to one revolution before they are cut to the policy type, a float
+		Julian Day would only resolve a quarter of a day.  The double
+		instantiations agree with the C functions to about 1e-11 degrees.
+
+********************************************************************************/
+template <typename Real> struct precision;
+
+template <> struct precision<float>
+{
+	typedef float real;
+
+	static constexpr float deg_rad = 0.01745329251994329577f;
+	static constexpr float rad_deg = 57.2957795130823208768f;
+
+	/* adding and subtracting 1.5 * 2^23 rounds to the nearest integer */
+	static constexpr float round_magic = 12582912.0f;
+
+	/* x - 90 * q is exact below this, larger angles go through fmod */
+	static constexpr float reduce_max = 2.0e7f;
+
+	static float sin_poly(float z, float z2)
+	{
+		return z + z * z2 * (-1.6666654611e-1f + z2 * (8.3321608736e-3f + z2 * -1.9515295891e-4f));
+	}
+
+	static float cos_poly(float z2)
+	{
+		return 1.0f - 0.5f * z2 + z2 * z2 * (4.166664568298827e-2f + z2 * (-1.388731625493765e-3f + z2 * 2.443315711809948e-5f));
+	}
+
+	/* measured error bounds */
+	static constexpr double trig_error = 1.0e-7;				/* sin_d, cos_d */
+	static constexpr double solar_coordinates_error = 1.0e-4;	/* alpha, delta */
+	static constexpr double azimuth_altitude_error = 5.0e-5;	/* A cos(h), h */
+	static constexpr double illumination_error = 1.0e-6;		/* k */
+};
+
+template <> struct precision<double>
+{
+	typedef double real;
+
+	static constexpr double deg_rad = 0.01745329251994329547437168;
+	static constexpr double rad_deg = 57.29577951308232286464772;
+
+	/* adding and subtracting 1.5 * 2^52 rounds to the nearest integer */
+	static constexpr double round_magic = 6755399441055744.0;
+
+	/* x - 90 * q is exact below this, larger angles go through fmod */
+	static constexpr double reduce_max = 1.0e15;
+
+	static double sin_poly(double z, double z2)
+	{
+		return z + z * z2 * (-1.66666666666666324348e-01 + z2 * (8.33333333332248946124e-03
+			+ z2 * (-1.98412698298579493134e-04 + z2 * (2.75573137070700676789e-06
+			+ z2 * (-2.50507602534068634195e-08 + z2 * 1.58969099521155010221e-10)))));
+	}
+
+	static double cos_poly(double z2)
+	{
+		return 1.0 - 0.5 * z2 + z2 * z2 * (4.16666666666666019037e-02 + z2 * (-1.38888888888741095749e-03
+			+ z2 * (2.48015872894767294178e-05 + z2 * (-2.75573143513906633035e-07
+			+ z2 * (2.08757232129817482790e-09 + z2 * -1.13596475577881948265e-11)))));
+	}
+
+	/* measured error bounds */
+	static constexpr double trig_error = 2.0e-16;
+	static constexpr double solar_coordinates_error = 1.5e-13;
+	static constexpr double azimuth_altitude_error = 5.0e-14;
+	static constexpr double illumination_error = 1.5e-15;
+};
+
+/* equatorial and horizontal coordinates in degrees */
+template <typename Real> struct equatorial
+{
+	Real	alpha;		/* right ascension */
+	Real	delta;		/* declination */
+};
+
+template <typename Real> struct horizontal
+{
+	Real	A;			/* azimuth west of south */
+	Real	h;			/* altitude */
+};
+
+/*******************************************************************************
+	NAME:
+		sincos_d_kernel
+		sincos_d
+		sin_d
+		cos_d
+		tan_d
+
+	PURPOSE:
+		Trigonometric functions in degrees in the policy precision
+
+	INPUT ARGUMENTS:
+		x (Real)
+			input angle in degrees, |x| < reduce_max for sincos_d_kernel
+
+	OUTPUT ARGUMENTS:
+		s, c (Real)
+			sine and cosine of x, sincos_d_kernel and sincos_d only
+
+	NOTES:
+		Same reduction as SinCosD, to the nearest multiple of 90 in degrees,
+		exact +0 and +/-1 at multiples of 90.  sincos_d_kernel has no branches
+		or calls so loops over it vectorize, twice as wide in float.  The
+		others first send angles beyond reduce_max, infinities and NaN through
+		fmod, which keeps them scalar.
+
+********************************************************************************/
+template <typename Real>
+inline void sincos_d_kernel(Real x, Real &s, Real &c)
+{
+	typedef precision<Real> P;
+
+	const Real	q = (x * (Real(1) / Real(90)) + P::round_magic) - P::round_magic;		/* nearest multiple of 90 */
+	const Real	e = q - Real(4) * ((q * Real(0.25) + P::round_magic) - P::round_magic);	/* quadrant, -2..2 */
+	const Real	z = (x - Real(90) * q) * P::deg_rad;
+	const Real	z2 = z * z;
+	const Real	odd = ( std::fabs(e) == Real(1) ) ? Real(1) : Real(0);
+	const Real	sz = P::sin_poly(z, z2);
+	const Real	cz = P::cos_poly(z2);
+
+	/* adding 0 turns the -0 of an exact zero into +0, as in aa_sincosd_kernel */
+	s = ( odd * cz + (Real(1) - odd) * sz ) * ( std::fabs(e - Real(0.5)) < Real(1) ? Real(1) : Real(-1) ) + Real(0);
+	c = ( odd * sz + (Real(1) - odd) * cz ) * ( std::fabs(e + Real(0.5)) < Real(1) ? Real(1) : Real(-1) ) + Real(0);
+}
+
+template <typename Real>
+inline void sincos_d(Real x, Real &s, Real &c)
+{
+	if ( !(std::fabs(x) < precision<Real>::reduce_max) )
+		x = std::fmod(x, Real(360));
+
+	sincos_d_kernel(x, s, c);
+}
+
+template <typename Real>
+inline Real sin_d(Real x)
+{
+	Real	s, c;
+
+	sincos_d(x, s, c);
+	return s;
+}
+
+template <typename Real>
+inline Real cos_d(Real x)
+{
+	Real	s, c;
+
+	sincos_d(x, s, c);
+	return c;
+}
+
+template <typename Real>
+inline Real tan_d(Real x)
+{
+	Real	s, c;
+
+	sincos_d(x, s, c);
+	return s / c;
+}
+
+/*******************************************************************************
+	NAME:
+		revolution
+
+	PURPOSE:
+		Revolution() in any precision, angle reduced to 0..360
+
+********************************************************************************/
+template <typename Real>
+inline Real revolution(Real theta)
+{
+	if ( theta >= 0 )
+		return std::fmod(theta, Real(360));
+	else
+		return Real(360) + std::fmod(theta, Real(360));
+}
+
+/*******************************************************************************
+	NAME:
+		app_solar_coordinates
+
+	PURPOSE:
+		Apparent right ascension and declination of the sun, the algorithm of
+		app_solar_coordinates() in the policy precision
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 151-153
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day at TD, at UT when aa_set_auto_delta_t() is on
+
+	RETURNED VALUE:
+		alpha and delta in degrees (equatorial<Real>)
+
+	NOTES:
+		Error bound precision<Real>::solar_coordinates_error
+
+********************************************************************************/
+template <typename Real>
+inline equatorial<Real> app_solar_coordinates(double JD)
+{
+	typedef precision<Real> P;
+
+	const double	T = julian_centuries(aa_get_auto_delta_t() ? ::ut_to_tt(JD) : JD);
+
+	/* geometric mean longitude, mean anomaly and node of the sun */
+	const Real	L0 = Real(revolution(280.46645 + 36000.76983 * T + 0.0003032 * T * T));
+	const Real	M = Real(revolution(357.52910 + 35999.05030 * T - 0.0001559 * T * T - 0.00000048 * T * T * T));
+	const Real	omega = Real(revolution(125.04 - 1934.136 * T));
+	const Real	t = Real(T);
+
+	Real	sinM, cosM, sinOmega, cosOmega, sinLamda, cosLamda, sinEp0, cosEp0;
+	Real	C, lamda, ep0;
+	equatorial<Real>	result;
+
+	sincos_d_kernel(M, sinM, cosM);
+	sincos_d_kernel(omega, sinOmega, cosOmega);
+
+	/* equation of center, sin 2M and sin 3M from the multiple angle formulas */
+	C = (Real(1.914600) - Real(0.004817) * t - Real(0.000014) * t * t) * sinM
+		+ (Real(0.019993) - Real(0.000101) * t) * Real(2) * sinM * cosM
+		+ Real(0.000290) * sinM * (Real(3) - Real(4) * sinM * sinM);
+
+	/* apparent longitude */
+	lamda = revolution(L0 + C - Real(0.00569) - Real(0.00478) * sinOmega);
+
+	/* obliquity of the ecliptic corrected for nutation */
+	ep0 = (Real(84381.448) - Real(46.8150) * t - Real(0.00059) * t * t + Real(0.001813) * t * t * t) / Real(3600)
+		+ Real(0.00256) * cosOmega;
+
+	sincos_d_kernel(lamda, sinLamda, cosLamda);
+	sincos_d_kernel(ep0, sinEp0, cosEp0);
+
+	result.alpha = revolution(std::atan2(cosEp0 * sinLamda, cosLamda) * P::rad_deg);
+	result.delta = std::asin(sinEp0 * sinLamda) * P::rad_deg;
+
+	return result;
+}
+
+/*******************************************************************************
+	NAME:
+		azimuth_altitude
+		azimuth_altitude_sidereal
+
+	PURPOSE:
+		Azimuth and altitude, the algorithm of azimuth_altitude() in the
+		policy precision
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 87-90
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day at UT
+		theta0 (double)
+			apparent sidereal time at Greenwich in degrees, computed once for
+			a whole grid with app_sidereal_time()
+		alpha, delta (Real)
+			apparent right ascension and declination in degrees
+		L, phi (Real)
+			longitude, positive west, and latitude in degrees
+
+	RETURNED VALUE:
+		azimuth west of south and altitude in degrees (horizontal<Real>)
+
+	NOTES:
+		Same formulas as azimuth_altitude() multiplied through by cos(delta)
+		and with the altitude from atan2 instead of asin, which loses half
+		the digits near the zenith and would dominate the error in float.
+		Error bound precision<Real>::azimuth_altitude_error, applies to the
+		altitude and to the azimuth times cos(h)
+
+********************************************************************************/
+template <typename Real>
+inline horizontal<Real> azimuth_altitude_sidereal(double theta0, Real alpha, Real delta, Real L, Real phi)
+{
+	typedef precision<Real> P;
+
+	/* local hour angle in double, then reduced */
+	const Real	H = Real(revolution(theta0 - double(L) - double(alpha)));
+
+	Real	sinH, cosH, sinPhi, cosPhi, sinDelta, cosDelta;
+	Real	x, y, z;
+	horizontal<Real>	result;
+
+	sincos_d_kernel(H, sinH, cosH);
+	sincos_d_kernel(phi, sinPhi, cosPhi);
+	sincos_d_kernel(delta, sinDelta, cosDelta);
+
+	/* horizontal unit vector, x south, y west, z zenith */
+	x = cosH * cosDelta * sinPhi - sinDelta * cosPhi;
+	y = sinH * cosDelta;
+	z = sinPhi * sinDelta + cosPhi * cosDelta * cosH;
+
+	result.A = std::atan2(y, x) * P::rad_deg;
+	result.h = std::atan2(z, std::sqrt(x * x + y * y)) * P::rad_deg;
+
+	return result;
+}
+
+template <typename Real>
+inline horizontal<Real> azimuth_altitude(double JD, Real alpha, Real delta, Real L, Real phi)
+{
+	return azimuth_altitude_sidereal(app_sidereal_time(JD), alpha, delta, L, phi);
+}
+
+/*******************************************************************************
+	NAME:
+		simple_illumination
+
+	PURPOSE:
+		Illuminated fraction of the moon's disk, the algorithm of
+		simple_illumination() in the policy precision
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 316
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day at TD, at UT when aa_set_auto_delta_t() is on
+
+	RETURNED VALUE:
+		illuminated fraction 0..1 (Real)
+
+	NOTES:
+		Error bound precision<Real>::illumination_error
+
+********************************************************************************/
+template <typename Real>
+inline Real simple_illumination(double JD)
+{
+	const double	T = julian_centuries(aa_get_auto_delta_t() ? ::ut_to_tt(JD) : JD);
+
+	/* mean elongation of the moon, mean anomalies of the sun and moon */
+	const Real	D = Real(std::fmod(297.8502042 + 445267.1115168 * T - 0.0016300 * T * T
+						+ T * T * T / 545868 - T * T * T * T / 113065000, 360.0));
+	const Real	M = Real(std::fmod(357.5291092 + 35999.0502909 * T - 0.0001536 * T * T
+						+ T * T * T / 24490000, 360.0));
+	const Real	Mprime = Real(std::fmod(134.9634114 + 477198.8676313 * T + 0.0089970 * T * T
+						+ T * T * T / 69699 - T * T * T * T / 14712000, 360.0));
+
+	/* phase angle of the moon */
+	const Real	i = Real(180) - D - Real(6.289) * sin_d(Mprime)
+						+ Real(2.100) * sin_d(M)
+						- Real(1.274) * sin_d(Real(2) * D - Mprime)
+						- Real(0.658) * sin_d(Real(2) * D)
+						- Real(0.214) * sin_d(Real(2) * Mprime)
+						- Real(0.110) * sin_d(D);
+
+	return (Real(1) + cos_d(i)) / Real(2);
+}
+
+} /* namespace astroalgo */
+
+#endif /* _ASTROPRECISION_HPP */
@@ -4,6 +4,10 @@
 /* C Headers */
 #include <math.h>
 
+static void horizontal_coordinates( double theta0, double alpha, double delta, double L, double phi, double *A, double *h);
+static void horizontal_coordinates_site( double theta0, double alpha, double delta, double L,
+	double sinPhi, double cosPhi, double *A, double *h);
+
 /*******************************************************************************
 	NAME:
 		AzimuthAltitude
@@ -40,7 +44,7 @@
 	 	none
 	 
 	FUNCTIONS CALLED:
-	 	AppSiderealTime, Revolution, atan2, asin
+	 	AppSiderealTime, Revolution, SinCosD, atan2, asin
 	 
 	DATE/PROGRAMMER/NOTE:
 		07-05-2000	Todd A. Guillory	created, minor inaccuracy due to not calculating apparent sidereal time
@@ -48,18 +52,107 @@
 ********************************************************************************/
 void azimuth_altitude( double JD, double alpha, double delta, double L, double phi, double *A, double *h)
 {
-	double	theta0,	/* apparent sidereal time at Greenwich*/
-			H;		/* local hour angle */
-				
-	theta0 = app_sidereal_time(JD);
+	horizontal_coordinates(app_sidereal_time(JD), alpha, delta, L, phi, A, h);
+}
+
+/* as azimuth_altitude, the instant t at UT */
+void azimuth_altitude_instant( aaInstant t, double alpha, double delta, double L, double phi, double *A, double *h)
+{
+	horizontal_coordinates(app_sidereal_time_instant(t), alpha, delta, L, phi, A, h);
+}
+
+/* as azimuth_altitude, the apparent sidereal time from the epoch */
+void azimuth_altitude_ctx( const aaEpoch *epoch, double alpha, double delta, double L, double phi, double *A, double *h)
+{
+	horizontal_coordinates(epoch->theta, alpha, delta, L, phi, A, h);
+}
+
+/* as azimuth_altitude, for the site of the observer */
+void azimuth_altitude_obs( const aaObserver *observer, double JD, double alpha, double delta, double *A, double *h)
+{
+	horizontal_coordinates_site(app_sidereal_time(JD), alpha, delta, observer->L,
+		observer->sinPhi, observer->cosPhi, A, h);
+}
+
+/* as azimuth_altitude, for the site of the observer and the sidereal time of the epoch */
+void azimuth_altitude_obs_ctx( const aaObserver *observer, const aaEpoch *epoch, double alpha, double delta, double *A, double *h)
+{
+	horizontal_coordinates_site(epoch->theta, alpha, delta, observer->L,
+		observer->sinPhi, observer->cosPhi, A, h);
+}
+
+/* the computation of azimuth_altitude for apparent sidereal time theta0 in degrees */
+static void horizontal_coordinates( double theta0, double alpha, double delta, double L, double phi, double *A, double *h)
+{
+	double	sinPhi, cosPhi;
+	
+	SinCosD(phi, &sinPhi, &cosPhi);
+	
+	horizontal_coordinates_site(theta0, alpha, delta, L, sinPhi, cosPhi, A, h);
+}
+
+/* the same with the latitude trig given */
+static void horizontal_coordinates_site( double theta0, double alpha, double delta, double L,
+	double sinPhi, double cosPhi, double *A, double *h)
+{
+	double	H,		/* local hour angle */
+			sinH, cosH,
+			sinDelta, cosDelta;
 	
 	/* calculate local hour angle */
 	/* normalize the hour angle to +0 to +360 degrees */
 	H = Revolution(theta0 - L - alpha);
 	
-	/* calculate azimuth */
-	*A = atan2( SinD(H), (CosD(H) * SinD(phi) - TanD(delta) * CosD(phi)) ) * kRadDeg;
+	SinCosD(H, &sinH, &cosH);
+	SinCosD(delta, &sinDelta, &cosDelta);
+	
+	/* calculate azimuth, both coordinates times cos delta so the poles, where */
+	/* SinCosD gives a cos delta of -0, come out north and south */
+	*A = atan2( cosDelta * sinH, (cosDelta * cosH * sinPhi - sinDelta * cosPhi) ) * kRadDeg;
 	
 	/* calculate altitude */
-	*h = asin( SinD(phi) * SinD(delta) + CosD(phi) * CosD(delta) * CosD(H) ) * kRadDeg;
+	*h = asin( sinPhi * sinDelta + cosPhi * cosDelta * cosH ) * kRadDeg;
+}
+
+/*******************************************************************************
+	NAME:
+		hour_angle
+		hour_angle_obs
+		
+	PURPOSE:
+		Computes the local hour angle of a body
+		
+	REFERENCES;
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 88
+			
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day UT
+		L (double)
+			longitude in degrees, positive west, or from the observer
+		alpha (double)
+	 		apparent right ascention in degrees
+	
+	OUTPUT ARGUMENTS:
+	 	none
+	 
+	RETURNED VALUE:
+	 	local hour angle in degrees, -180 to +180, positive west of the meridian
+	 
+	GLOBALS USED:
+	 	none
+	 
+	FUNCTIONS CALLED:
+	 	app_sidereal_time, revolution_180
+	
+********************************************************************************/
+double hour_angle( double JD, double L, double alpha )
+{
+	return revolution_180(app_sidereal_time(JD) - L - alpha);
+}
+
+double hour_angle_obs( const aaObserver *observer, double JD, double alpha )
+{
+	return revolution_180(app_sidereal_time(JD) - observer->L - alpha);
 }
@@ -0,0 +1,153 @@
+#include "astroalgo.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+
+/* dates come in blocks so one odd date does not send a whole array down */
+/* the slow path */
+#define CAL_BLOCK			256
+
+/* Julian Day written for dates that fall in the Gregorian reform */
+#ifdef NAN
+	#define CAL_NAN			NAN
+#else
+	#define CAL_NAN			(HUGE_VAL - HUGE_VAL)
+#endif
+
+/* floor(a / b) for b > 0 */
+static AA_INLINE long long cal_floor_div(long long a, long long b)
+{
+	return a / b - ( a % b < 0 );
+}
+
+/* kernel loops for each instruction set, see batchcalendar_kernels.h */
+#define BATCH_KERNELS	"batchcalendar_kernels.h"
+#include "batchisa.h"
+
+/* dispatch table indexed by IsaLevels, isa_scalar loops over the scalar */
+/* functions in date_to_julian_n and julian_to_date_n */
+typedef struct
+{
+	void	(*date_to_julian_gregorian)(const short *month, const double *day, const int *year, double *JD, int n);
+	int		(*date_to_julian_mixed)(const short *month, const double *day, const int *year, double *JD, int n);
+	void	(*julian_to_date_gregorian)(const double *JD, short *month, double *day, int *year, int n);
+	int		(*julian_to_date_mixed)(const double *JD, short *month, double *day, int *year, int n);
+} BatchCalendarKernels;
+
+#define CAL_KERNELS(isa)	{ date_to_julian_gregorian_##isa, date_to_julian_mixed_##isa, \
+							  julian_to_date_gregorian_##isa, julian_to_date_mixed_##isa }
+
+static const BatchCalendarKernels batch_calendar[] = BATCH_TABLE(CAL_KERNELS(sse2), CAL_KERNELS);
+
+/*******************************************************************************
+	NAME:
+		date_to_julian_n
+		julian_to_date_n
+		
+	PURPOSE:
+		date_to_julian and julian_to_date over arrays
+		
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 59-63
+		Neri, C. and Schneider, L. "Euclidean affine functions and their
+			application to calendar algorithms." Software: Practice and
+			Experience 53(4), 2023.
+			
+	INPUT ARGUMENTS:
+		month[], day[], year[] (short, double, int)
+			dates, month 1-12
+		JD[] (double)
+			Julian Days
+		n (int)
+			number of dates
+	
+	OUTPUT ARGUMENTS:
+		JD[] (double)
+			Julian Days, NaN for dates in 10/5/1582 - 10/14/1582
+		month[], day[], year[] (short, double, int)
+			dates
+	 
+	RETURNED VALUE:
+		1 if every date converted, 0 if any failed
+	 
+	GLOBALS USED:
+		none
+	 
+	FUNCTIONS CALLED:
+		aa_get_isa, date_to_julian, julian_to_date
+	 	
+	NOTES:
+		Meeus' floors of decimal fractions are written as exact integer
+		quotients, INT(30.6001 (M + 1)) becomes the Euclidean affine function
+		122 + (979 M - 2919) / 32 of Neri and Schneider, so the results are
+		bit for bit those of the scalar functions.
+		
+		Each block of CAL_BLOCK dates is checked first, blocks that are all
+		Gregorian with years up to 1,000,000 (Julian Days up to 20,000,000)
+		run a branch free 32 bit loop that vectorizes, other blocks a 64
+		bit loop that handles the Julian calendar and the reform.
+	 
+********************************************************************************/
+int date_to_julian_n(const short *month, const double *day, const int *year, double *JD, int n)
+{
+	const BatchCalendarKernels	*k = &batch_calendar[aa_get_isa()];
+	int							i, j, len, gregorian, gaps = 0;
+	
+	if ( aa_get_isa() == isa_scalar )
+	{
+		for ( i = 0; i < n; ++i )
+			if ( !date_to_julian(month[i], day[i], year[i], &JD[i]) )
+			{
+				JD[i] = CAL_NAN;
+				++gaps;
+			}
+		return gaps == 0;
+	}
+	
+	for ( i = 0; i < n; i += CAL_BLOCK )
+	{
+		len = ( n - i < CAL_BLOCK ) ? n - i : CAL_BLOCK;
+		
+		gregorian = 1;
+		for ( j = i; j < i + len; ++j )
+			gregorian &= ( year[j] > 1582 ) & ( year[j] <= 1000000 );
+		
+		if ( gregorian )
+			k->date_to_julian_gregorian(month + i, day + i, year + i, JD + i, len);
+		else
+			gaps += k->date_to_julian_mixed(month + i, day + i, year + i, JD + i, len);
+	}
+	
+	return gaps == 0;
+}
+
+int julian_to_date_n(const double *JD, short *month, double *day, int *year, int n)
+{
+	const BatchCalendarKernels	*k = &batch_calendar[aa_get_isa()];
+	int							i, j, len, gregorian, bad = 0;
+	
+	if ( aa_get_isa() == isa_scalar )
+	{
+		for ( i = 0; i < n; ++i )
+			bad += !julian_to_date(JD[i], &month[i], &day[i], &year[i]);
+		return bad == 0;
+	}
+	
+	for ( i = 0; i < n; i += CAL_BLOCK )
+	{
+		len = ( n - i < CAL_BLOCK ) ? n - i : CAL_BLOCK;
+		
+		gregorian = 1;
+		for ( j = i; j < i + len; ++j )
+			gregorian &= ( JD[j] >= 2299160.5 ) & ( JD[j] < 19999999.5 );
+		
+		if ( gregorian )
+			k->julian_to_date_gregorian(JD + i, month + i, day + i, year + i, len);
+		else
+			bad += k->julian_to_date_mixed(JD + i, month + i, day + i, year + i, len);
+	}
+	
+	return bad == 0;
+}
@@ -0,0 +1,93 @@
+/* batch calendar kernels, included once per instruction set */
+/* by batchcalendar.c through batchisa.h, no include guard */
+
+/* Gregorian dates with years 1583 - 1,000,000, 32 bit integers throughout */
+static BATCH_TARGET void BATCH_NAME(date_to_julian_gregorian)(const short *month, const double *day, const int *year, double *JD, int n)
+{
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		int		s = ( month[i] <= 2 );
+		int		y = year[i] - s;
+		int		m = month[i] + 12 * s;
+		int		a = y / 100;
+
+		JD[i] = (double) ( (1461 * (y + 4716)) / 4 + 122 + ((979 * m - 2919) >> 5) )
+			+ day[i] + (double) (2 - a + a / 4) - 1524.5;
+	}
+}
+
+/* any date, Julian before the reform, NaN inside it, 64 bit integers */
+/* returns the number of dates that fall in the reform */
+static BATCH_TARGET int BATCH_NAME(date_to_julian_mixed)(const short *month, const double *day, const int *year, double *JD, int n)
+{
+	int		i, gaps = 0;
+
+	for ( i = 0; i < n; ++i )
+	{
+		long long	s = ( month[i] <= 2 );
+		long long	y = year[i] - s;
+		long long	m = month[i] + 12 * s;
+		long long	a = y / 100;
+		long long	cal = cal_floor_div(1461 * (y + 4716), 4) + 122 + ((979 * m - 2919) >> 5);
+		int			after = year[i] > 1582 || ( year[i] == 1582 && ( month[i] > 10 || ( month[i] == 10 && day[i] >= 15 ) ) );
+		int			gap = year[i] == 1582 && month[i] == 10 && day[i] >= 5 && day[i] < 15;
+		long long	B = after ? 2 - a + a / 4 : 0;
+
+		JD[i] = gap ? CAL_NAN : (double) cal + day[i] + (double) B - 1524.5;
+		gaps += gap;
+	}
+
+	return gaps;
+}
+
+/* Julian Days 2299160.5 - 19999999.5, Gregorian dates, 32 bit integers */
+static BATCH_TARGET void BATCH_NAME(julian_to_date_gregorian)(const double *JD, short *month, double *day, int *year, int n)
+{
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		double	J = JD[i] + 0.5;
+		int		z = (int) J;			/* J is positive, truncation is floor */
+		double	Z = (double) z;
+		int		alpha = (4 * z - 7468865) / 146097;
+		int		B = z + 1 + alpha - alpha / 4 + 1524;
+		int		C = (100 * B - 12210) / 36525;
+		int		D = (1461 * C) / 4;
+		int		E = (10000 * (B - D)) / 306001;
+		int		m = ( E < 14 ) ? E - 1 : E - 13;
+
+		day[i] = (double) (B - D - (306001 * E) / 10000) + (J - Z);
+		month[i] = (short) m;
+		year[i] = C - ( ( m > 2 ) ? 4716 : 4715 );
+	}
+}
+
+/* any Julian Day, 64 bit integers, returns the number of failed conversions */
+static BATCH_TARGET int BATCH_NAME(julian_to_date_mixed)(const double *JD, short *month, double *day, int *year, int n)
+{
+	int		i, bad = 0;
+
+	for ( i = 0; i < n; ++i )
+	{
+		double		J = JD[i] + 0.5;
+		double		Z = floor(J);
+		long long	z = (long long) Z;
+		long long	alpha = cal_floor_div(4 * z - 7468865, 146097);
+		long long	A = ( z >= 2299161 ) ? z + 1 + alpha - cal_floor_div(alpha, 4) : z;
+		long long	B = A + 1524;
+		long long	C = cal_floor_div(100 * B - 12210, 36525);
+		long long	D = cal_floor_div(1461 * C, 4);
+		long long	E = cal_floor_div(10000 * (B - D), 306001);
+		long long	m = ( E < 14 ) ? E - 1 : E - 13;
+
+		day[i] = (double) (B - D - cal_floor_div(306001 * E, 10000)) + (J - Z);
+		month[i] = (short) m;
+		year[i] = (int) (C - ( ( m > 2 ) ? 4716 : 4715 ));
+		bad += ( E > 15 || m < 1 );
+	}
+
+	return bad;
+}
@@ -0,0 +1,114 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+/* kernel loops for each instruction set, see batchhorizontal_kernels.h */
+#define BATCH_KERNELS	"batchhorizontal_kernels.h"
+#include "batchisa.h"
+
+/* reference loop, the computation of azimuth_altitude with the C library */
+static void horizontal_n_scalar(double theta0, double L, double sinPhi, double cosPhi,
+	const double *alpha, const double *delta, double *A, double *h, int n)
+{
+	double	sinH, cosH, sinDelta, cosDelta;
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		SinCosD(Revolution(theta0 - L - alpha[i]), &sinH, &cosH);
+		SinCosD(delta[i], &sinDelta, &cosDelta);
+
+		A[i] = atan2(cosDelta * sinH, cosDelta * cosH * sinPhi - sinDelta * cosPhi) * kRadDeg;
+		h[i] = asin(sinPhi * sinDelta + cosPhi * cosDelta * cosH) * kRadDeg;
+	}
+}
+
+/* dispatch table indexed by IsaLevels */
+static void (* const batch_horizontal[])(double theta0, double L, double sinPhi, double cosPhi,
+	const double *alpha, const double *delta, double *A, double *h, int n) =
+	BATCH_FUNCTIONS(horizontal_n);
+
+/*******************************************************************************
+	NAME:
+		azimuth_altitude_n
+		azimuth_altitude_obs_ctx_n
+
+	PURPOSE:
+		Computes the azimuth and altitude of many targets seen from one site
+		at one instant
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 87-90
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day UT
+		*observer (aaObserver), *epoch (aaEpoch)
+			the site and the apparent sidereal time for
+			azimuth_altitude_obs_ctx_n, in place of JD, L and phi
+		alpha[] (double)
+			apparent right ascensions in degrees
+		delta[] (double)
+			apparent declinations in degrees
+		L (double)
+			longitude in degrees, positive west
+		phi (double)
+			latitude in degrees
+		n (int)
+			number of targets
+
+	OUTPUT ARGUMENTS:
+		A[] (double)
+			azimuth in degrees west of south
+		h[] (double)
+			altitude in degrees
+
+	RETURNED VALUE:
+		none
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		app_sidereal_time, aa_get_isa, SinCosD
+
+	NOTES:
+		Every target gives what azimuth_altitude gives within 1e-8
+		degrees.  The apparent sidereal time, with its nutation, and the
+		latitude trig are computed once for the call instead of once per
+		target, and the loop over the targets has no branches or calls so
+		it vectorizes, with the kernels of astrointernal.h for the trig,
+		atan2 and asin.  At a declination of +90 or -90 the azimuth is that
+		of the pole, north or south, as azimuth_altitude gives it.
+
+********************************************************************************/
+void azimuth_altitude_n(double JD, const double *alpha, const double *delta, double L, double phi,
+	double *A, double *h, int n)
+{
+	double	sinPhi, cosPhi;
+
+	if ( n <= 0 )
+		return;
+
+	SinCosD(phi, &sinPhi, &cosPhi);
+
+	batch_horizontal[aa_get_isa()](app_sidereal_time(JD), L, sinPhi, cosPhi, alpha, delta, A, h, n);
+}
+
+void azimuth_altitude_obs_ctx_n(const aaObserver *observer, const aaEpoch *epoch,
+	const double *alpha, const double *delta, double *A, double *h, int n)
+{
+	if ( n <= 0 )
+		return;
+
+	batch_horizontal[aa_get_isa()](epoch->theta, observer->L, observer->sinPhi, observer->cosPhi,
+		alpha, delta, A, h, n);
+}
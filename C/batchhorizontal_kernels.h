@@ -0,0 +1,23 @@
+/* batch horizontal coordinate kernels, included once per instruction set */
+/* by batchhorizontal.c through batchisa.h, no include guard */
+
+/* azimuth and altitude of n targets for apparent sidereal time theta0 and a site */
+/* at longitude L, no branches or calls in the loop */
+static BATCH_TARGET void BATCH_NAME(horizontal_n)(double theta0, double L, double sinPhi, double cosPhi,
+	const double *alpha, const double *delta, double *A, double *h, int n)
+{
+	double	theta = theta0 - L;
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		double	sinH, cosH, sinDelta, cosDelta;
+
+		aa_sincosd_kernel(theta - alpha[i], &sinH, &cosH);
+		aa_sincosd_kernel(delta[i], &sinDelta, &cosDelta);
+
+		/* pp. 89, both coordinates of the azimuth times cos delta */
+		A[i] = aa_atan2d_kernel(cosDelta * sinH, cosDelta * cosH * sinPhi - sinDelta * cosPhi);
+		h[i] = aa_asind_kernel(sinPhi * sinDelta + cosPhi * cosDelta * cosH);
+	}
+}
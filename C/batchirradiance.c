@@ -0,0 +1,231 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+/* total solar irradiance at 1 AU in W/m^2, Kopp and Lean 2011 */
+#define SOLAR_CONSTANT		1361.0
+
+/* the sun is computed, and every site runs over the times, in blocks of this many */
+#define GEOMETRY_BLOCK		256
+
+/* a site with its latitude and plane trig computed once */
+typedef struct
+{
+	double		L;							/* longitude, degrees positive west */
+	double		sinPhi, cosPhi;				/* latitude */
+	double		sinTilt, cosTilt;			/* tilt of the plane from horizontal */
+	double		sinGamma, cosGamma;			/* azimuth of the plane's normal, west of south */
+} SolarSite;
+
+/* kernel loops for each instruction set, see batchirradiance_kernels.h */
+#define BATCH_KERNELS	"batchirradiance_kernels.h"
+#include "batchisa.h"
+
+/* reference loop, the computation of azimuth_altitude with the C library */
+static void solar_geometry_n_scalar(const double *gha, const double *sinDelta,
+	const double *cosDelta, const SolarSite *site, double *zenith, double *A, double *cosIncidence, int n)
+{
+	double	sinH, cosH, sinA, cosA, sinAlt, cosAlt, h;
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		SinCosD(Revolution(gha[i] - site->L), &sinH, &cosH);
+
+		A[i] = atan2(cosDelta[i] * sinH, cosDelta[i] * cosH * site->sinPhi - sinDelta[i] * site->cosPhi) * kRadDeg;
+		h = asin(site->sinPhi * sinDelta[i] + site->cosPhi * cosDelta[i] * cosH) * kRadDeg;
+		zenith[i] = 90.0 - h;
+
+		SinCosD(A[i], &sinA, &cosA);
+		SinCosD(h, &sinAlt, &cosAlt);
+		cosIncidence[i] = sinAlt * site->cosTilt
+			+ cosAlt * site->sinTilt * (cosA * site->cosGamma + sinA * site->sinGamma);
+	}
+}
+
+/* dispatch table indexed by IsaLevels */
+static void (* const batch_geometry[])(const double *gha, const double *sinDelta, const double *cosDelta,
+	const SolarSite *site, double *zenith, double *A, double *cosIncidence, int n) =
+	BATCH_FUNCTIONS(solar_geometry_n);
+
+/* the sun for every time of the grid, the sites and the outputs */
+typedef struct
+{
+	void				(*kernel)(const double *, const double *, const double *, const SolarSite *,
+							double *, double *, double *, int);
+	const double		*gha, *sinDelta, *cosDelta;
+	const SolarSite		*site;
+	double				*zenith, *A, *cosIncidence;
+	int					nt;
+} SolarGeometryGrid;
+
+/* every time of the sites begin to end, in blocks, one chunk of aa_parallel_for */
+static void solar_geometry_sites(void *context, int begin, int end)
+{
+	const SolarGeometryGrid	*grid = (const SolarGeometryGrid *) context;
+	size_t					k;
+	int						i, s, len;
+
+	for ( s = begin; s < end; ++s )
+		for ( i = 0; i < grid->nt; i += GEOMETRY_BLOCK )
+		{
+			len = ( grid->nt - i < GEOMETRY_BLOCK ) ? grid->nt - i : GEOMETRY_BLOCK;
+			k = (size_t) s * (size_t) grid->nt + (size_t) i;
+
+			grid->kernel(grid->gha + i, grid->sinDelta + i, grid->cosDelta + i, &grid->site[s],
+				grid->zenith + k, grid->A + k, grid->cosIncidence + k, len);
+		}
+}
+
+/*******************************************************************************
+	NAME:
+		solar_geometry_grid
+
+	PURPOSE:
+		Computes the position of the sun seen from many sites over a regular
+		grid of times: zenith angle, azimuth, the cosine of the angle of
+		incidence on a tilted plane, and the irradiance at the top of the
+		atmosphere
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 87-90, 151-153
+		Duffie, J. A. and Beckman, W. A. "Solar Engineering of Thermal
+			Processes, 4th ed." Wiley. 2013. section 1.6 for the incidence
+		Kopp, G. and Lean, J. L. "A new, lower value of total solar
+			irradiance." Geophysical Research Letters 38. 2011.
+
+	INPUT ARGUMENTS:
+		JD (double)
+			first Julian Day UT of the grid
+		step (double)
+			grid spacing in days, e.g. 1.0 / 1440 for every minute
+		nt (int)
+			number of times
+		L[] (double)
+			longitudes in degrees, positive west
+		phi[] (double)
+			latitudes in degrees
+		tilt[] (double)
+			tilts of the planes from horizontal in degrees, or NULL for
+			horizontal planes
+		gamma[] (double)
+			azimuths of the normals of the planes in degrees west of south,
+			0 for a plane facing south, or NULL for 0
+		ns (int)
+			number of sites
+
+	OUTPUT ARGUMENTS:
+		zenith[] (double)
+			zenith angle of the sun in degrees, ns * nt
+		A[] (double)
+			azimuth in degrees west of south, ns * nt
+		cosIncidence[] (double)
+			cosine of the angle between the sun and the normal of the plane,
+			negative when the sun is behind it, ns * nt
+		E0[] (double)
+			normal irradiance at the top of the atmosphere in W/m^2, nt, or
+			NULL
+
+	RETURNED VALUE:
+		1 on success, 0 for an empty grid or when out of memory
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		app_solar_coordinates_grid, app_sidereal_time, aa_get_isa, SinCosD,
+		aa_parallel_for
+
+	NOTES:
+		Site major, the value for site s and time t is at s * nt + t.
+
+		The sun is computed once per time with app_solar_coordinates_grid,
+		which applies DeltaT when aa_set_auto_delta_t() is on, and the trig
+		of every site once for the call.  Every site then runs over the
+		times in blocks, in a loop with no branches or calls, vectorized as
+		app_solar_coordinates_n, with sin zenith found from the azimuth
+		instead of a square root.  The sites are spread over the threads of
+		aa_set_threads().  The results agree with azimuth_altitude within
+		1e-8 degrees, the three outputs must not overlap.
+
+		The irradiance on a plane above the atmosphere is
+		E0 * max(cosIncidence, 0) for a sun above the horizon.
+
+********************************************************************************/
+int solar_geometry_grid(double JD, double step, int nt,
+	const double *L, const double *phi, const double *tilt, const double *gamma, int ns,
+	double *zenith, double *A, double *cosIncidence, double *E0)
+{
+	SolarGeometryGrid	grid;
+	SolarSite			*site;
+	double				alpha[GEOMETRY_BLOCK], delta[GEOMETRY_BLOCK], R[GEOMETRY_BLOCK],
+						*gha, *sinDelta, *cosDelta;
+	int					i, j, s, len;
+
+	if ( nt <= 0 || ns <= 0 )
+		return 0;
+
+	site = (SolarSite *) malloc((size_t) ns * sizeof(SolarSite));
+	gha = (double *) malloc(3 * (size_t) nt * sizeof(double));
+	if ( site == NULL || gha == NULL )
+	{
+		free(site);
+		free(gha);
+		return 0;
+	}
+	sinDelta = gha + nt;
+	cosDelta = sinDelta + nt;
+
+	/* the sun and the Greenwich hour angle, once for all the sites */
+	for ( i = 0; i < nt; i += GEOMETRY_BLOCK )
+	{
+		len = ( nt - i < GEOMETRY_BLOCK ) ? nt - i : GEOMETRY_BLOCK;
+
+		app_solar_coordinates_grid(JD + (double) i * step, step, len, alpha, delta, NULL, R);
+
+		for ( j = 0; j < len; ++j )
+		{
+			gha[i + j] = app_sidereal_time(JD + (double) (i + j) * step) - alpha[j];
+			SinCosD(delta[j], &sinDelta[i + j], &cosDelta[i + j]);
+
+			if ( E0 != NULL )
+				E0[i + j] = SOLAR_CONSTANT / (R[j] * R[j]);
+		}
+	}
+
+	/* the site trig, once for all the times */
+	for ( s = 0; s < ns; ++s )
+	{
+		site[s].L = L[s];
+		SinCosD(phi[s], &site[s].sinPhi, &site[s].cosPhi);
+		SinCosD(( tilt != NULL ) ? tilt[s] : 0, &site[s].sinTilt, &site[s].cosTilt);
+		SinCosD(( gamma != NULL ) ? gamma[s] : 0, &site[s].sinGamma, &site[s].cosGamma);
+	}
+
+	grid.kernel = batch_geometry[aa_get_isa()];
+	grid.gha = gha;
+	grid.sinDelta = sinDelta;
+	grid.cosDelta = cosDelta;
+	grid.site = site;
+	grid.nt = nt;
+	grid.zenith = zenith;
+	grid.A = A;
+	grid.cosIncidence = cosIncidence;
+
+	aa_parallel_for(ns, 1 + AA_PARALLEL_CELLS / nt, solar_geometry_sites, &grid);
+
+	free(site);
+	free(gha);
+
+	return 1;
+}
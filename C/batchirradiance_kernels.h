@@ -0,0 +1,37 @@
+/* batch solar geometry kernels, included once per instruction set */
+/* by batchirradiance.c through batchisa.h, no include guard */
+
+/* zenith, azimuth and incidence at one site for n times given the Greenwich hour */
+/* angle and the declination trig of the sun, no branches or calls in the loop */
+static BATCH_TARGET void BATCH_NAME(solar_geometry_n)(const double *gha, const double *sinDelta,
+	const double *cosDelta, const SolarSite *site,
+	double * AA_RESTRICT zenith, double * AA_RESTRICT A, double * AA_RESTRICT cosIncidence, int n)
+{
+	double	L = site->L,
+			sinPhi = site->sinPhi, cosPhi = site->cosPhi,
+			sinTilt = site->sinTilt, cosTilt = site->cosTilt,
+			sinGamma = site->sinGamma, cosGamma = site->cosGamma;
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		double	sinH, cosH, sinA, cosA, x, y, c, h, a;
+
+		aa_sincosd_kernel(gha[i] - L, &sinH, &cosH);
+
+		/* the horizontal coordinates times cos delta, pp. 89, and cos zenith */
+		x = cosDelta[i] * sinH;
+		y = cosDelta[i] * cosH * sinPhi - sinDelta[i] * cosPhi;
+		c = sinPhi * sinDelta[i] + cosPhi * cosDelta[i] * cosH;
+
+		a = aa_atan2d_kernel(x, y);
+
+		/* sin zenith as the projection of (x, y) on the azimuth, no sqrt */
+		aa_sincosd_kernel(a, &sinA, &cosA);
+		h = x * sinA + y * cosA;
+
+		A[i] = a;
+		zenith[i] = aa_atan2d_kernel(h, c);
+		cosIncidence[i] = c * cosTilt + sinTilt * (y * cosGamma + x * sinGamma);
+	}
+}
@@ -0,0 +1,25 @@
+/* includes the batch kernel file named by BATCH_KERNELS once per instruction set */
+/* with BATCH_ISA the name suffix and BATCH_TARGET the target attribute, see */
+/* BATCH_NAME in astrointernal.h, all three are undefined again, no include guard */
+
+#define BATCH_ISA		sse2
+#define BATCH_TARGET
+#include BATCH_KERNELS
+#undef BATCH_ISA
+#undef BATCH_TARGET
+
+#if AA_ISA_DISPATCH
+#define BATCH_ISA		avx2
+#define BATCH_TARGET	AA_TARGET_AVX2
+#include BATCH_KERNELS
+#undef BATCH_ISA
+#undef BATCH_TARGET
+
+#define BATCH_ISA		avx512
+#define BATCH_TARGET	AA_TARGET_AVX512
+#include BATCH_KERNELS
+#undef BATCH_ISA
+#undef BATCH_TARGET
+#endif
+
+#undef BATCH_KERNELS
@@ -0,0 +1,207 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+/* times go through a block buffer when they are made or corrected on the way */
+#define SOLAR_BLOCK			256
+
+/* kernel loops for each instruction set, see batchsolar_kernels.h */
+#define BATCH_KERNELS	"batchsolar_kernels.h"
+#include "batchisa.h"
+
+/* reference loop over the scalar computation */
+static void solar_coordinates_n_scalar(const double *JD, double *alpha, double *delta,
+	double *lambda, double *R, int n)
+{
+	double	E;
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+		solar_coordinates_T(julian_centuries(JD[i]), &alpha[i], &delta[i], &lambda[i], &R[i], &E);
+}
+
+/* dispatch table indexed by IsaLevels */
+static void (* const batch_solar[])(const double *JD, double *alpha, double *delta,
+	double *lambda, double *R, int n) =
+	BATCH_FUNCTIONS(solar_coordinates_n);
+
+/* reference loop over the scalar computation */
+static void solar_time_n_scalar(const double *JD, double L, double *t, double *E, int n)
+{
+	double	alpha, delta, lambda, R;
+	int		i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		solar_coordinates_T(julian_centuries(JD[i]), &alpha, &delta, &lambda, &R, &E[i]);
+		t[i] = Revolution(360.0 * (JD[i] - 2451545.0) + E[i] / 4.0 - L + 180.0) / 15.0;
+	}
+}
+
+/* dispatch table indexed by IsaLevels */
+static void (* const batch_solar_time[])(const double *JD, double L, double *t, double *E, int n) =
+	BATCH_FUNCTIONS(solar_time_n);
+
+/* JD[] or the grid JD + i * step, in blocks, DeltaT added when applied */
+static void solar_coordinates_blocks(const double *JD, double JD0, double step, int n,
+	double *alpha, double *delta, double *lambda, double *R)
+{
+	void		(*kernel)(const double *, double *, double *, double *, double *, int) = batch_solar[aa_get_isa()];
+	double		times[SOLAR_BLOCK], lambdas[SOLAR_BLOCK], radii[SOLAR_BLOCK];
+	const double	*t;
+	int			i, j, len, correct = aa_get_auto_delta_t();
+
+	for ( i = 0; i < n; i += SOLAR_BLOCK )
+	{
+		len = ( n - i < SOLAR_BLOCK ) ? n - i : SOLAR_BLOCK;
+
+		if ( JD != NULL && !correct )
+			t = JD + i;
+		else
+		{
+			for ( j = 0; j < len; ++j )
+				times[j] = ( JD != NULL ) ? JD[i + j] : JD0 + (double) (i + j) * step;
+			if ( correct )
+				for ( j = 0; j < len; ++j )
+					times[j] = ut_to_tt(times[j]);
+			t = times;
+		}
+
+		kernel(t, alpha + i, delta + i, ( lambda != NULL ) ? lambda + i : lambdas,
+			( R != NULL ) ? R + i : radii, len);
+	}
+}
+
+/*******************************************************************************
+	NAME:
+		app_solar_coordinates_n
+		app_solar_coordinates_grid
+
+	PURPOSE:
+		app_solar_coordinates over an array of Julian Days or a regular grid,
+		with the apparent longitude and radius vector on request
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 151-153
+
+	INPUT ARGUMENTS:
+		JD[] (double)
+			Julian Days TD, UT when aa_set_auto_delta_t() is on
+		JD (double)
+			first Julian Day of the grid
+		step (double)
+			grid spacing in days, e.g. 1.0 / 1440 for every minute
+		n (int)
+			number of times
+
+	OUTPUT ARGUMENTS:
+		alpha[] (double)
+			apparent right ascension in degrees
+		delta[] (double)
+			apparent declination in degrees
+		lambda[] (double)
+			apparent longitude of the sun in degrees, or NULL
+		R[] (double)
+			radius vector in AU, or NULL
+
+	RETURNED VALUE:
+		none
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		aa_get_isa, aa_get_auto_delta_t, ut_to_tt, solar_coordinates_T
+
+	NOTES:
+		Structure of arrays in and out.  The loop has no branches or calls,
+		the trig and atan2 are the polynomial kernels of astrointernal.h and
+		the declination comes from tan delta = tan epsilon sin alpha instead
+		of asin, so it vectorizes and runs the AVX2 or AVX-512 build when the
+		CPU has it.  The results agree with app_solar_coordinates to about 1e-12
+		degrees and are the same for every instruction set but isa_scalar,
+		which loops over the scalar computation.
+
+		Grid times are JD + i * step, computed afresh for every i so there is
+		no drift over long grids.
+
+********************************************************************************/
+void app_solar_coordinates_n(const double *JD, double *alpha, double *delta, double *lambda, double *R, int n)
+{
+	solar_coordinates_blocks(JD, 0, 0, n, alpha, delta, lambda, R);
+}
+
+void app_solar_coordinates_grid(double JD, double step, int n, double *alpha, double *delta, double *lambda, double *R)
+{
+	solar_coordinates_blocks(NULL, JD, step, n, alpha, delta, lambda, R);
+}
+
+/*******************************************************************************
+	NAME:
+		apparent_solar_time_n
+
+	PURPOSE:
+		Converts Julian Days UT to local apparent solar time, the time a
+		sundial shows, over an array
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			ch. 27 formula 27.3
+
+	INPUT ARGUMENTS:
+		JD[] (double)
+			Julian Days UT, e.g. from timestamps_to_julian
+		L (double)
+			longitude in degrees, positive west
+		n (int)
+			number of times
+
+	OUTPUT ARGUMENTS:
+		t[] (double)
+			local apparent solar time in hours, 0..24, 12 at the transit
+		E[] (double)
+			equation of time in minutes, or NULL
+
+	RETURNED VALUE:
+		none
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		aa_get_isa, solar_coordinates_T, Revolution
+
+	NOTES:
+		t is UT less L / 15 hours plus the equation of time, as in
+		aa_solar_record, the loop vectorizes as app_solar_coordinates_n.
+		The equation of time is evaluated at UT whether or not
+		aa_set_auto_delta_t() is on, DeltaT changes it by less than 0.03
+		seconds, and UTC passed for UT by less than 0.9 seconds.
+
+********************************************************************************/
+void apparent_solar_time_n(const double *JD, double L, double *t, double *E, int n)
+{
+	void		(*kernel)(const double *, double, double *, double *, int) = batch_solar_time[aa_get_isa()];
+	double		eot[SOLAR_BLOCK];
+	int			i, len;
+
+	if ( E != NULL )
+	{
+		kernel(JD, L, t, E, n);
+		return;
+	}
+
+	for ( i = 0; i < n; i += SOLAR_BLOCK )
+	{
+		len = ( n - i < SOLAR_BLOCK ) ? n - i : SOLAR_BLOCK;
+		kernel(JD + i, L, t + i, eot, len);
+	}
+}
@@ -0,0 +1,75 @@
+/* batch solar coordinate kernels, included once per instruction set */
+/* by batchsolar.c through batchisa.h, no include guard */
+
+/* app_solar_coordinates for Julian Days TD, no branches or calls in the loop */
+static BATCH_TARGET void BATCH_NAME(solar_coordinates_n)(const double *JD, double *alpha, double *delta,
+	double *lambda, double *R, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+	{
+		double	T = (JD[i] - 2451545.0) / 36525.0,
+				L0 = 280.46645 + 36000.76983 * T + 0.0003032 * T * T,
+				M = 357.52910 + 35999.05030 * T - 0.0001559 * T * T - 0.00000048 * T * T * T,
+				e = 0.016708617 - 0.000042037 * T - 0.0000001236 * T * T,
+				omega = 125.04 - 1934.136 * T,
+				ep0 = (((23*60)+26)*60+21.448 - 46.8150 * T - 0.00059 * T * T + 0.001813 * T * T * T) / 3600,
+				sinM, cosM, sinV, cosV, sinOmega, cosOmega, sinLamda, cosLamda, sinEp0, cosEp0,
+				sinAlpha, cosAlpha, C, lamda, a;
+		
+		aa_sincosd_kernel(M, &sinM, &cosM);
+		aa_sincosd_kernel(omega, &sinOmega, &cosOmega);
+		
+		/* equation of center, sin 2M and sin 3M from the multiple angle formulas */
+		C = (1.914600 - 0.004817 * T - 0.000014 * T * T) * sinM
+			+ (0.019993 - 0.000101 * T) * 2.0 * sinM * cosM
+			+ 0.000290 * sinM * (3.0 - 4.0 * sinM * sinM);
+		
+		/* radius vector from the true anomaly M + C */
+		aa_sincosd_kernel(M + C, &sinV, &cosV);
+		R[i] = (1.000001018 * ( 1 - e * e)) / ( 1 + e * cosV );
+		
+		/* apparent longitude and corrected obliquity */
+		lamda = aa_revolution_kernel(L0 + C - 0.00569 - 0.00478 * sinOmega);
+		ep0 = ep0 + 0.00256 * cosOmega;
+		
+		aa_sincosd_kernel(lamda, &sinLamda, &cosLamda);
+		aa_sincosd_kernel(ep0, &sinEp0, &cosEp0);
+		
+		/* tan delta = tan epsilon sin alpha, pp. 89, keeps asin and sqrt out of the loop */
+		a = aa_revolution_kernel(aa_atan2d_kernel(cosEp0 * sinLamda, cosLamda));
+		aa_sincosd_kernel(a, &sinAlpha, &cosAlpha);
+		alpha[i] = a;
+		delta[i] = aa_atan2d_kernel(sinEp0 * sinAlpha, cosEp0);
+		lambda[i] = lamda;
+	}
+}
+
+/* local apparent solar time in hours at longitude L for Julian Days UT, */
+/* and the equation of time in minutes */
+static BATCH_TARGET void BATCH_NAME(solar_time_n)(const double *JD, double L, double *t, double *E, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+	{
+		double	T = (JD[i] - 2451545.0) / 36525.0,
+				L0 = 280.46645 + 36000.76983 * T + 0.0003032 * T * T,
+				M = 357.52910 + 35999.05030 * T - 0.0001559 * T * T - 0.00000048 * T * T * T,
+				e = 0.016708617 - 0.000042037 * T - 0.0000001236 * T * T,
+				omega = 125.04 - 1934.136 * T,
+				ep0 = (((23*60)+26)*60+21.448 - 46.8150 * T - 0.00059 * T * T + 0.001813 * T * T * T) / 3600,
+				sinM, cosM, sinOmega, cosOmega, sinEp0, cosEp0, eot;
+		
+		aa_sincosd_kernel(M, &sinM, &cosM);
+		aa_sincosd_kernel(omega, &sinOmega, &cosOmega);
+		aa_sincosd_kernel(ep0 + 0.00256 * cosOmega, &sinEp0, &cosEp0);
+		
+		eot = aa_equation_of_time_kernel(L0, sinM, cosM, e, cosEp0);
+		
+		/* hour angle of the true sun from 12h UT, plus 12 hours */
+		t[i] = aa_revolution_kernel(360.0 * (JD[i] - 2451545.0) + eot / 4.0 - L + 180.0) / 15.0;
+		E[i] = eot;
+	}
+}
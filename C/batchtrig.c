@@ -0,0 +1,142 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+/* largest angle in degrees reduced with the polynomial kernel */
+#define TRIG_MAXANGLE		1.0e15
+
+/* kernel loops for each instruction set, see batchtrig_kernels.h */
+#define BATCH_KERNELS	"batchtrig_kernels.h"
+#include "batchisa.h"
+
+/* reference loops over the scalar functions */
+static void sind_n_scalar(const double *x, double *y, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+		y[i] = SinD(x[i]);
+}
+
+static void cosd_n_scalar(const double *x, double *y, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+		y[i] = CosD(x[i]);
+}
+
+static void sincosd_n_scalar(const double *x, double *s, double *c, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+	{
+		s[i] = SinD(x[i]);
+		c[i] = CosD(x[i]);
+	}
+}
+
+/* dispatch table indexed by IsaLevels */
+typedef struct
+{
+	void	(*sind_n)(const double *x, double *y, int n);
+	void	(*cosd_n)(const double *x, double *y, int n);
+	void	(*sincosd_n)(const double *x, double *s, double *c, int n);
+} BatchTrigKernels;
+
+#define TRIG_KERNELS(isa)	{ sind_n_##isa, cosd_n_##isa, sincosd_n_##isa }
+
+static const BatchTrigKernels batch_trig[] = BATCH_TABLE(TRIG_KERNELS(scalar), TRIG_KERNELS);
+
+/*******************************************************************************
+	NAME:
+		SinD_n
+		CosD_n
+		SinCosD_n
+		
+	PURPOSE:
+		Trigonometic functions in degrees over arrays
+		
+	REFERENCES:
+		none
+			
+	INPUT ARGUMENTS:
+		x[] (double)
+			input angles in degrees
+		n (int)
+			number of angles
+	
+	OUTPUT ARGUMENTS:
+	 	y[], s[] (double)
+	 		sines, or cosines for CosD_n
+	 	c[] (double)
+	 		cosines
+	 
+	 RETURNED VALUE:
+	 	none
+	 
+	 GLOBALS USED:
+	 	none
+	 
+	 FUNCTIONS CALLED:
+	 	aa_get_isa, aa_sincosd_kernel, SinD, CosD, SinCosD
+	 	
+	NOTES:
+		Outputs must not overlap x.  Results are within 2 ulp of the sine and
+		cosine of the exact angle in degrees for |x| < 1e15 and within 6e-16 of
+		SinD and CosD for |x| <= 360, where most of the difference is the
+		rounding of x * kDegRad in the scalar versions.  Larger angles,
+		infinities and NaN fall back to SinCosD, which reduces them modulo
+		360 exactly before converting to radians.
+		
+		The kernel loop is built for each instruction set level and the one
+		picked by aa_get_isa() is called.  All compiled levels give identical
+		results, isa_scalar calls SinD and CosD for every element.
+	 
+********************************************************************************/
+void SinD_n(const double *x, double *y, int n)
+{
+	double	c;
+	int		i;
+	
+	batch_trig[aa_get_isa()].sind_n(x, y, n);
+	
+	/* patch up huge angles, infinities and NaN with SinCosD, which reduces */
+	/* the degrees exactly with fmod */
+	for ( i = 0; i < n; ++i )
+		if ( !(fabs(x[i]) < TRIG_MAXANGLE) )
+			SinCosD(x[i], &y[i], &c);
+}
+
+void CosD_n(const double *x, double *y, int n)
+{
+	double	s;
+	int		i;
+	
+	batch_trig[aa_get_isa()].cosd_n(x, y, n);
+	
+	/* patch up huge angles, infinities and NaN with SinCosD */
+	for ( i = 0; i < n; ++i )
+		if ( !(fabs(x[i]) < TRIG_MAXANGLE) )
+			SinCosD(x[i], &s, &y[i]);
+}
+
+void SinCosD_n(const double *x, double *s, double *c, int n)
+{
+	int		i;
+	
+	batch_trig[aa_get_isa()].sincosd_n(x, s, c, n);
+	
+	/* patch up huge angles, infinities and NaN with SinCosD */
+	for ( i = 0; i < n; ++i )
+		if ( !(fabs(x[i]) < TRIG_MAXANGLE) )
+			SinCosD(x[i], &s[i], &c[i]);
+}
@@ -0,0 +1,28 @@
+/* batch trig kernels, included once per instruction set */
+/* by batchtrig.c through batchisa.h, no include guard */
+
+static BATCH_TARGET void BATCH_NAME(sind_n)(const double *x, double *y, int n)
+{
+	double	c;
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+		aa_sincosd_kernel(x[i], &y[i], &c);
+}
+
+static BATCH_TARGET void BATCH_NAME(cosd_n)(const double *x, double *y, int n)
+{
+	double	s;
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+		aa_sincosd_kernel(x[i], &s, &y[i]);
+}
+
+static BATCH_TARGET void BATCH_NAME(sincosd_n)(const double *x, double *s, double *c, int n)
+{
+	int		i;
+	
+	for ( i = 0; i < n; ++i )
+		aa_sincosd_kernel(x[i], &s[i], &c[i]);
+}
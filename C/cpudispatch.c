@@ -0,0 +1,173 @@
+#include "astroalgo.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <stdlib.h>
+#include <string.h>
+
+/* instruction set used by the batch kernels, -1 until first use */
+static int		aa_isa = -1;
+
+/*******************************************************************************
+	NAME:
+		aa_isa_supported
+		
+	PURPOSE:
+		Tests whether this build and this processor can run the batch kernels
+		compiled for an instruction set
+		
+	REFERENCES:
+		none
+			
+	INPUT ARGUMENTS:
+		level (IsaLevels)
+			instruction set to test
+	
+	OUTPUT ARGUMENTS:
+		none
+	 
+	RETURNED VALUE:
+		1 if supported, 0 if not
+	 
+	GLOBALS USED:
+		none
+	 
+	FUNCTIONS CALLED:
+		__builtin_cpu_supports
+	 	
+	NOTES:
+		isa_scalar and isa_sse2 are always available, isa_sse2 is the kernel
+		built for the compiler's baseline target, SSE2 on x86-64.
+	
+********************************************************************************/
+int aa_isa_supported(IsaLevels level)
+{
+	switch ( level )
+	{
+		case isa_scalar:
+		case isa_sse2:
+			return 1;
+#if AA_ISA_DISPATCH
+		case isa_avx2:
+			return __builtin_cpu_supports("avx2") ? 1 : 0;
+		case isa_avx512:
+			return __builtin_cpu_supports("avx512f") ? 1 : 0;
+#endif
+		default:
+			return 0;
+	}
+}
+
+/*******************************************************************************
+	NAME:
+		aa_isa_detect
+		
+	PURPOSE:
+		Picks the best instruction set the processor reports, limited by the
+		ASTROALGO_ISA environment variable when it is set
+		
+	REFERENCES:
+		none
+			
+	INPUT ARGUMENTS:
+		none
+	
+	OUTPUT ARGUMENTS:
+		none
+	 
+	RETURNED VALUE:
+		instruction set level (IsaLevels)
+	 
+	GLOBALS USED:
+		none
+	 
+	FUNCTIONS CALLED:
+		aa_isa_supported, getenv, strcmp
+	 	
+	NOTES:
+		ASTROALGO_ISA is one of scalar, sse2, avx2 or avx512.  A level the
+		processor cannot run falls back to the best one below it, unknown
+		names are ignored.
+	
+********************************************************************************/
+static IsaLevels aa_isa_detect(void)
+{
+	const char	*env = getenv("ASTROALGO_ISA");
+	int			level = isa_avx512;
+	
+	if ( env != NULL )
+	{
+		if ( strcmp(env, "scalar") == 0 )
+			level = isa_scalar;
+		else if ( strcmp(env, "sse2") == 0 )
+			level = isa_sse2;
+		else if ( strcmp(env, "avx2") == 0 )
+			level = isa_avx2;
+	}
+	
+	while ( !aa_isa_supported((IsaLevels) level) )
+		--level;
+	
+	return (IsaLevels) level;
+}
+
+/*******************************************************************************
+	NAME:
+		aa_get_isa
+		aa_set_isa
+		
+	PURPOSE:
+		Returns or overrides the instruction set used by the batch kernels
+		
+	REFERENCES:
+		none
+			
+	INPUT ARGUMENTS:
+		level (IsaLevels)
+			instruction set to use
+	
+	OUTPUT ARGUMENTS:
+		none
+	 
+	RETURNED VALUE:
+		aa_get_isa: current level (IsaLevels)
+		aa_set_isa: 1 if the level was selected, 0 if it is not supported
+	 
+	GLOBALS USED:
+		aa_isa
+	 
+	FUNCTIONS CALLED:
+		aa_isa_detect, aa_isa_supported
+	 	
+	NOTES:
+		The level is detected once, at load time where the compiler supports
+		constructors and otherwise on the first batch call.  Every thread
+		detects the same value so a racing first call is harmless.
+		aa_set_isa is meant for tests, call it before starting threads.
+	
+********************************************************************************/
+IsaLevels aa_get_isa(void)
+{
+	if ( aa_isa < 0 )
+		aa_isa = aa_isa_detect();
+	
+	return (IsaLevels) aa_isa;
+}
+
+int aa_set_isa(IsaLevels level)
+{
+	if ( !aa_isa_supported(level) )
+		return 0;
+	
+	aa_isa = level;
+	return 1;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+static void aa_isa_init(void) __attribute__((constructor));
+
+static void aa_isa_init(void)
+{
+	aa_get_isa();
+}
+#endif
@@ -1,6 +1,5 @@
 #include "astroalgo.h"
-
-#include <math.h>
+#include "astrointernal.h"
 
 /*******************************************************************************
 	NAME:
@@ -30,48 +29,45 @@
 	 	1 if input date is valid
 	 
 	FUNCTIONS CALLED:
-	 	none
+	 	aa_calendar_days, aa_gregorian_days
 	 
 	DATE/PROGRAMMER/NOTES:
 		10-15-1998	Todd A. Guillory	created
 	 	
 	NOTES:
 		you have to test if the input date is a valid date to begin with
+		
+		The integer parts are exact integer arithmetic and are added in the
+		same order as before, so results are bit for bit those of the floor
+		version, for |inYear| < 1,000,000.
 	
 ********************************************************************************/
 int date_to_julian(short inMonth, double inDay, int inYear, double *JD)
 {
-	double		A,B;
-	short		theMonth = inMonth;
-	int			theYear = inYear;
-  
-	if ( inMonth <= 2 )
-		{ --theYear;  theMonth += 12;  }
-   
-	A = floor(theYear/100);
-  
+	long		B;
+	
 	if ( inYear < 1582 )
 		B = 0;
-	else if (inYear > 1582 )
-		B = 2 - A + floor(A/4);
+	else if ( inYear > 1582 )
+		B = aa_gregorian_days(inYear, inMonth);
 	else
-    {
+	{
 		if ( inMonth < 10 )
 			B = 0;
 		else if ( inMonth > 10 )
-			B = 2 - A + floor(A/4);
+			B = aa_gregorian_days(inYear, inMonth);
 		else
 		{
 			if ( inDay < 5 )
 				B = 0;
 			else if ( inDay >= 15 )
-				B = 2 - A + floor(A/4);
+				B = aa_gregorian_days(inYear, inMonth);
 			else
 				{ return 0; } /* error, days falls on 10/5/1582 - 10/14/1582 */
-		} /* end middle else */   
+		} /* end middle else */
 	} /* end outer else */
-  
-  *JD = ( floor(365.25 * (theYear + 4716)) + floor(30.6001 * (theMonth + 1 )) + inDay + B - 1524.5 );
-  
-  return 1;
+	
+	*JD = (double) aa_calendar_days(inYear, inMonth) + inDay + (double) B - 1524.5;
+	
+	return 1;
 }
@@ -0,0 +1,240 @@
+#include "astroalgo.h"
+
+/* C Headers */
+#include <math.h>
+
+/* first year and spacing in years of deltat_table */
+#define DELTAT_FIRST_YEAR	1620
+#define DELTAT_STEP			2
+#define DELTAT_COUNT		(sizeof(deltat_table) / sizeof(deltat_table[0]))
+#define DELTAT_LAST_YEAR	(DELTAT_FIRST_YEAR + DELTAT_STEP * ((int) DELTAT_COUNT - 1))
+
+/* years over which the polynomials are blended into the ends of the table */
+#define DELTAT_BLEND_PAST	100.0
+#define DELTAT_BLEND_FUTURE	26.0
+
+/* TD - UT in seconds at the start of every second year, 1620 - 1998 from */
+/* Meeus table 10.A, 2000 - 2024 from the IERS Bulletins */
+static const double	deltat_table[] =
+{
+	/* 1620 */	121, 112, 103, 95, 88, 82, 77, 72, 68, 63,
+	/* 1640 */	60, 56, 53, 51, 48, 46, 44, 42, 40, 38,
+	/* 1660 */	35, 33, 31, 29, 26, 24, 22, 20, 18, 16,
+	/* 1680 */	14, 12, 11, 10, 9, 8, 7, 7, 7, 7,
+	/* 1700 */	7, 7, 8, 8, 9, 9, 9, 9, 9, 10,
+	/* 1720 */	10, 10, 10, 10, 10, 10, 10, 11, 11, 11,
+	/* 1740 */	11, 11, 12, 12, 12, 12, 13, 13, 13, 14,
+	/* 1760 */	14, 14, 14, 15, 15, 15, 15, 15, 16, 16,
+	/* 1780 */	16, 16, 16, 16, 16, 16, 15, 15, 14, 13,
+	/* 1800 */	13.1, 12.5, 12.2, 12.0, 12.0, 12.0, 12.0, 12.0, 12.0, 11.9,
+	/* 1820 */	11.6, 11.0, 10.2, 9.2, 8.2, 7.1, 6.2, 5.6, 5.4, 5.3,
+	/* 1840 */	5.4, 5.6, 5.9, 6.2, 6.5, 6.8, 7.1, 7.3, 7.5, 7.6,
+	/* 1860 */	7.7, 7.3, 6.2, 5.2, 2.7, 1.4, -1.2, -2.8, -3.8, -4.8,
+	/* 1880 */	-5.5, -5.3, -5.6, -5.7, -5.9, -6.0, -6.3, -6.5, -6.2, -4.7,
+	/* 1900 */	-2.8, -0.1, 2.6, 5.3, 7.7, 10.4, 13.3, 16.0, 18.2, 20.2,
+	/* 1920 */	21.1, 22.4, 23.5, 23.8, 24.3, 24.0, 23.9, 23.9, 23.7, 24.0,
+	/* 1940 */	24.3, 25.3, 26.2, 27.3, 28.2, 29.1, 30.0, 30.7, 31.4, 32.2,
+	/* 1960 */	33.1, 34.0, 35.0, 36.5, 38.3, 40.2, 42.2, 44.5, 46.5, 48.5,
+	/* 1980 */	50.5, 52.2, 53.8, 54.9, 55.8, 56.9, 58.3, 60.0, 61.6, 63.0,
+	/* 2000 */	63.8, 64.3, 64.6, 64.8, 65.5, 66.1, 66.6, 67.3, 68.1, 69.0,
+	/* 2020 */	69.4, 69.3, 69.2
+};
+
+/* apply delta_t() in the functions that take Dynamical Time, see aa_set_auto_delta_t() */
+static int	deltat_auto = 0;
+
+/* Espenak and Meeus polynomials, year y, for the years outside the table */
+static double delta_t_polynomial(double y)
+{
+	double	u;
+
+	if ( y < -500 )
+	{
+		u = (y - 1820) / 100;
+		return -20 + 32 * u * u;
+	}
+	else if ( y < 500 )
+	{
+		u = y / 100;
+		return 10583.6 + u * (-1014.41 + u * (33.78311 + u * (-5.952053 + u * (-0.1798452 + u * (0.022174192 + u * 0.0090316521)))));
+	}
+	else if ( y < 1600 )
+	{
+		u = (y - 1000) / 100;
+		return 1574.2 + u * (-556.01 + u * (71.23472 + u * (0.319781 + u * (-0.8503463 + u * (-0.005050998 + u * 0.0083572073)))));
+	}
+	else if ( y < 1700 )
+	{
+		u = y - 1600;
+		return 120 + u * (-0.9808 + u * (-0.01532 + u / 7129));
+	}
+	else if ( y < 2050 )
+	{
+		u = y - 2000;
+		return 62.92 + u * (0.32217 + u * 0.005589);
+	}
+	else if ( y < 2150 )
+	{
+		u = (y - 1820) / 100;
+		return -20 + 32 * u * u - 0.5628 * (2150 - y);
+	}
+
+	u = (y - 1820) / 100;
+	return -20 + 32 * u * u;
+}
+
+/*******************************************************************************
+	NAME:
+		delta_t
+
+	PURPOSE:
+		Returns DeltaT = TD - UT, the difference between Dynamical Time and
+		Universal Time
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 71-75, table 10.A
+		Espenak, F. and Meeus, J. "Five Millennium Canon of Solar Eclipses:
+			-1999 to +3000." NASA/TP-2006-214141. 2006.
+		IERS Bulletin A and B, 2000-2024
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day, UT or TD, the difference does not matter here
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		DeltaT in seconds
+
+	GLOBALS USED:
+		deltat_table
+
+	FUNCTIONS CALLED:
+		floor
+
+	NOTES:
+		1620 - 2024 linear interpolation in a table of every second year,
+		indexed directly so the cost is the same for any date.  Outside it
+		the Espenak and Meeus polynomials, blended linearly into the end
+		values of the table over 100 years before 1620 and up to 2050 after
+		2024 so there is no jump.  Future values are predictions and
+		uncertain by several seconds within a decade.
+
+********************************************************************************/
+double delta_t(double JD)
+{
+	double	y = 2000.0 + (JD - 2451545.0) / 365.25,	/* decimal year */
+			x, i, w;
+
+	if ( y >= DELTAT_FIRST_YEAR && y < DELTAT_LAST_YEAR )
+	{
+		x = (y - DELTAT_FIRST_YEAR) / DELTAT_STEP;
+		i = floor(x);
+		return deltat_table[(int) i] + (x - i) * (deltat_table[(int) i + 1] - deltat_table[(int) i]);
+	}
+
+	if ( y < DELTAT_FIRST_YEAR )
+	{
+		w = 1.0 - (DELTAT_FIRST_YEAR - y) / DELTAT_BLEND_PAST;
+		x = deltat_table[0] - delta_t_polynomial(DELTAT_FIRST_YEAR);
+	}
+	else
+	{
+		w = 1.0 - (y - DELTAT_LAST_YEAR) / DELTAT_BLEND_FUTURE;
+		x = deltat_table[DELTAT_COUNT - 1] - delta_t_polynomial(DELTAT_LAST_YEAR);
+	}
+
+	return delta_t_polynomial(y) + ( ( w > 0 ) ? w * x : 0 );
+}
+
+/*******************************************************************************
+	NAME:
+		ut_to_tt
+		tt_to_ut
+
+	PURPOSE:
+		Converts a Julian Day between Universal Time and Dynamical Time
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 71
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day UT, or Julian Ephemeris Day TD for tt_to_ut
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		Julian Ephemeris Day TD, or Julian Day UT for tt_to_ut
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		delta_t
+
+	NOTES:
+		TT, Terrestrial Time, is the name TD goes by since 1991.  tt_to_ut
+		evaluates DeltaT at the UT it returns, so the two are inverses.
+
+********************************************************************************/
+double ut_to_tt(double JD)
+{
+	return JD + delta_t(JD) / 86400.0;
+}
+
+double tt_to_ut(double JDE)
+{
+	return JDE - delta_t(JDE - delta_t(JDE) / 86400.0) / 86400.0;
+}
+
+/*******************************************************************************
+	NAME:
+		aa_set_auto_delta_t
+		aa_get_auto_delta_t
+
+	PURPOSE:
+		Turns on or off applying delta_t() inside the functions that need
+		Dynamical Time
+
+	REFERENCES:
+		none
+
+	INPUT ARGUMENTS:
+		apply (int)
+			1 to apply, 0 (the default) to leave the time scales to the caller
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		aa_get_auto_delta_t: the current setting
+
+	GLOBALS USED:
+		deltat_auto
+
+	FUNCTIONS CALLED:
+		none
+
+	NOTES:
+		When on, app_solar_coordinates(), app_solar_coordinates_instant()
+		and simple_illumination() take UT and convert it with ut_to_tt(),
+		the sidereal times take their nutation at TD, and
+		rise_tran_set() uses delta_t() for the day instead of 0.  The _ctx
+		functions get the same from epoch_init().  Process wide, like
+		aa_set_tolerance().
+
+********************************************************************************/
+void aa_set_auto_delta_t(int apply)
+{
+	deltat_auto = ( apply != 0 );
+}
+
+int aa_get_auto_delta_t(void)
+{
+	return deltat_auto;
+}
@@ -0,0 +1,503 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define EPHEMERIS_MMAP		1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#else
+	#define EPHEMERIS_MMAP		0
+#endif
+
+/* file layout version, bump on any change to EphemerisHeader or the segments */
+#define EPHEMERIS_VERSION	2
+
+/* most coefficients per quantity and segment */
+#define EPHEMERIS_MAX_COEFFICIENTS	32
+
+/* segments are padded to whole cache lines of this many doubles */
+#define EPHEMERIS_ALIGN		8
+
+static const char	ephemeris_magic[8] = { 'A', 'A', 'E', 'P', 'H', 'E', 'M', '\0' };
+
+/* the first 64 bytes of the file, in the byte order of the machine that wrote it */
+typedef struct
+{
+	char		magic[8];			/* "AAEPHEM" */
+	int			version;			/* EPHEMERIS_VERSION */
+	int			headerSize;			/* sizeof(EphemerisHeader), where the segments start */
+	int			quantities;			/* eph_count */
+	int			coefficients;		/* per quantity and segment, degree + 1 */
+	int			segments;
+	int			stride;				/* doubles from one segment to the next */
+	double		JD;					/* first Julian Day TD covered */
+	double		span;				/* days per segment */
+	double		tolerance;			/* aa_set_tolerance arc seconds of the nutation */
+	int			model;				/* NutationModels the file was compiled with */
+	char		reserved[4];
+} EphemerisHeader;
+
+/* fails to compile unless the header is the 64 bytes the file format says */
+typedef char	EphemerisHeaderSize[( sizeof(EphemerisHeader) == 64 ) ? 1 : -1];
+
+/* every quantity of the file at Julian Day TD JD, alpha continued past 360 */
+static void ephemeris_sample(double JD, double alpha0, double value[eph_count])
+{
+	double	T = julian_centuries(JD),
+			lambda, E;
+
+	solar_coordinates_T(T, &value[eph_alpha], &value[eph_delta], &lambda, &value[eph_R], &E);
+	nutation(T, &value[eph_delta_psi], &value[eph_delta_epsilon]);
+	value[eph_illumination] = simple_illumination_T(T);
+
+	/* the right ascension of the first node plus less than half a turn */
+	value[eph_alpha] += 360.0 * floor((alpha0 - value[eph_alpha]) / 360.0 + 0.5);
+}
+
+/* Chebyshev coefficients of one segment from JD to JD + span, quantity after quantity */
+static void ephemeris_fit(double JD, double span, int coefficients, int stride, double *segment)
+{
+	double	value[EPHEMERIS_MAX_COEFFICIENTS][eph_count],
+			angle, sum;
+	int		j, k, q;
+
+	/* values at the Chebyshev nodes, the zeros of T_n */
+	for ( k = 0; k < coefficients; ++k )
+	{
+		angle = kPi * (k + 0.5) / coefficients;
+		ephemeris_sample(JD + 0.5 * span * (1.0 - cos(angle)), ( k == 0 ) ? 0 : value[0][eph_alpha], value[k]);
+	}
+
+	/* the nodes run from the start of the segment, at x = -cos(angle), so */
+	/* the odd coefficients change sign */
+	memset(segment, 0, stride * sizeof(double));
+
+	for ( q = 0; q < eph_count; ++q )
+		for ( j = 0; j < coefficients; ++j )
+		{
+			for ( sum = 0, k = 0; k < coefficients; ++k )
+				sum += value[k][q] * cos(kPi * j * (k + 0.5) / coefficients);
+
+			segment[q * coefficients + j] = (( j == 0 ) ? 1.0 : 2.0) * sum / coefficients * (( j & 1 ) ? -1.0 : 1.0);
+		}
+}
+
+/*******************************************************************************
+	NAME:
+		ephemeris_compile
+
+	PURPOSE:
+		Fits piecewise Chebyshev polynomials to the solar coordinates,
+		nutation and the illuminated fraction of the moon and writes them to
+		a file for ephemeris_open
+
+	REFERENCES:
+		Press, W. H. et al. "Numerical Recipes in C, 2nd ed." Cambridge
+			University Press. 1992. pp. 190-194
+
+	INPUT ARGUMENTS:
+		path (const char*)
+			file to write, replaced if it exists
+		JD (double)
+			first Julian Day TD to cover
+		days (double)
+			number of days to cover
+		span (double)
+			days per segment, 4 is a good choice
+		degree (int)
+			degree of the polynomials, 1 to 31, 13 is a good choice
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		1 if the file was written
+		0 for bad arguments or when the file cannot be written
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		solar_coordinates_T, nutation, simple_illumination_T, nutation_get_model,
+		aa_get_tolerance, fopen, fwrite, fclose, rename
+
+	NOTES:
+		Each quantity is interpolated at the degree + 1 Chebyshev nodes of
+		every segment.  Spans of 4 days at degree 13 follow the series to
+		about 3e-10 degrees, 5e-11 arc seconds of nutation and 3e-11 of the
+		illuminated fraction, at 704 bytes a segment, 6.4 MB a century.
+
+		The values are those of app_solar_coordinates, nutation and
+		simple_illumination with aa_set_auto_delta_t() off, with the
+		nutation model and tolerance set now, both kept in the file.  Right
+		ascension is continued past 360 degrees within a segment so it
+		stays smooth.
+
+		The file is written under a temporary name next to path and renamed
+		over it once complete, so processes that have the old file open
+		keep reading it whole and a failed compile leaves it in place.
+
+		The file is native byte order and double format, 64 byte header
+		then the segments one after the other, each quantity's coefficients
+		together and every segment padded to a multiple of 64 bytes.
+
+********************************************************************************/
+int ephemeris_compile(const char *path, double JD, double days, double span, int degree)
+{
+	EphemerisHeader	header;
+	FILE			*file;
+	char			*temp;
+	double			*segment, seconds;
+	int				i, ok;
+
+	if ( path == NULL || !(span > 0) || !(days > 0) || degree < 1 || degree >= EPHEMERIS_MAX_COEFFICIENTS
+		|| days / span >= 2147483647.0 )
+		return 0;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, ephemeris_magic, sizeof(header.magic));
+	header.version = EPHEMERIS_VERSION;
+	header.headerSize = sizeof(header);
+	header.quantities = eph_count;
+	header.coefficients = degree + 1;
+	header.segments = (int) ceil(days / span);
+	header.stride = (eph_count * header.coefficients + EPHEMERIS_ALIGN - 1) / EPHEMERIS_ALIGN * EPHEMERIS_ALIGN;
+	header.JD = JD;
+	header.span = span;
+	header.model = nutation_get_model();
+	aa_get_tolerance(&header.tolerance, &seconds);
+
+	/* the file is written beside path, with the process id so two compiles */
+	/* of the same path do not share it */
+	temp = (char *) malloc(strlen(path) + 32);
+	if ( temp == NULL )
+		return 0;
+#if EPHEMERIS_MMAP
+	sprintf(temp, "%s.%ld.tmp", path, (long) getpid());
+#else
+	sprintf(temp, "%s.tmp", path);
+#endif
+
+	segment = (double *) malloc(header.stride * sizeof(double));
+	file = fopen(temp, "wb");
+	ok = ( segment != NULL && file != NULL && fwrite(&header, sizeof(header), 1, file) == 1 );
+
+	for ( i = 0; ok && i < header.segments; ++i )
+	{
+		ephemeris_fit(JD + (double) i * span, span, header.coefficients, header.stride, segment);
+		ok = ( fwrite(segment, sizeof(double), header.stride, file) == (size_t) header.stride );
+	}
+
+	if ( file != NULL && fclose(file) != 0 )
+		ok = 0;
+
+	free(segment);
+
+#if !EPHEMERIS_MMAP
+	/* rename does not replace an existing file everywhere */
+	if ( ok )
+		remove(path);
+#endif
+
+	if ( ok && rename(temp, path) != 0 )
+		ok = 0;
+
+	if ( !ok && file != NULL )
+		remove(temp);
+
+	free(temp);
+
+	return ok;
+}
+
+/*******************************************************************************
+	NAME:
+		ephemeris_open
+		ephemeris_close
+
+	PURPOSE:
+		Maps a file written by ephemeris_compile into memory for the
+		ephemeris_ functions, and releases it
+
+	INPUT ARGUMENTS:
+		path (const char*)
+			the file
+
+	OUTPUT ARGUMENTS:
+		*ephemeris (aaEphemeris)
+			the open ephemeris, zeroed when the file cannot be used
+
+	RETURNED VALUE:
+		1 if the file was opened
+		0 if it cannot be read, is not an ephemeris, is of another version
+		or byte order, or is truncated
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		open, fstat, mmap, munmap, close, or fopen, fread, fclose without mmap
+
+	NOTES:
+		The file is mapped read only and shared, so every process reading
+		the same file uses the one copy in the page cache.  Where there is
+		no mmap it is read into memory.  An open ephemeris is only read,
+		any number of threads may use it at once.
+
+********************************************************************************/
+int ephemeris_open(aaEphemeris *ephemeris, const char *path)
+{
+	EphemerisHeader	header;
+	size_t			size;
+	void			*map;
+
+	memset(ephemeris, 0, sizeof(*ephemeris));
+
+#if EPHEMERIS_MMAP
+	{
+		struct stat		info;
+		int				fd = open(path, O_RDONLY);
+
+		if ( fd < 0 )
+			return 0;
+
+		if ( fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(header) )
+		{
+			close(fd);
+			return 0;
+		}
+
+		size = (size_t) info.st_size;
+		map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+
+		if ( map == MAP_FAILED )
+			return 0;
+	}
+#else
+	{
+		FILE	*file = fopen(path, "rb");
+		long	length;
+
+		if ( file == NULL )
+			return 0;
+
+		map = NULL;
+		if ( fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) >= (long) sizeof(header)
+			&& fseek(file, 0, SEEK_SET) == 0 && (map = malloc((size_t) length)) != NULL
+			&& fread(map, 1, (size_t) length, file) != (size_t) length )
+		{
+			free(map);
+			map = NULL;
+		}
+		fclose(file);
+
+		if ( map == NULL )
+			return 0;
+
+		size = (size_t) length;
+	}
+#endif
+
+	ephemeris->map = map;
+	ephemeris->size = size;
+	memcpy(&header, map, sizeof(header));
+
+	if ( memcmp(header.magic, ephemeris_magic, sizeof(header.magic)) != 0
+		|| header.version != EPHEMERIS_VERSION || header.headerSize != (int) sizeof(header)
+		|| header.quantities != eph_count || header.coefficients < 2
+		|| header.coefficients > EPHEMERIS_MAX_COEFFICIENTS
+		|| header.stride < eph_count * header.coefficients || header.segments < 1 || !(header.span > 0)
+		|| (size - sizeof(header)) / sizeof(double) / (size_t) header.stride < (size_t) header.segments )
+	{
+		ephemeris_close(ephemeris);
+		return 0;
+	}
+
+	ephemeris->data = (const double *) ((const char *) map + sizeof(header));
+	ephemeris->JD = header.JD;
+	ephemeris->span = header.span;
+	ephemeris->segments = header.segments;
+	ephemeris->coefficients = header.coefficients;
+	ephemeris->stride = header.stride;
+	ephemeris->model = (NutationModels) header.model;
+	ephemeris->tolerance = header.tolerance;
+
+	return 1;
+}
+
+void ephemeris_close(aaEphemeris *ephemeris)
+{
+	if ( ephemeris->map != NULL )
+	{
+#if EPHEMERIS_MMAP
+		munmap(ephemeris->map, ephemeris->size);
+#else
+		free(ephemeris->map);
+#endif
+	}
+
+	memset(ephemeris, 0, sizeof(*ephemeris));
+}
+
+/* the segment holding Julian Day TD JD and JD scaled to -1..1 in it, NULL outside */
+static const double *ephemeris_segment(const aaEphemeris *ephemeris, double JD, double *x)
+{
+	double	u;
+	int		i;
+
+	if ( ephemeris == NULL || ephemeris->data == NULL )
+		return NULL;
+
+	u = (JD - ephemeris->JD) / ephemeris->span;
+
+	if ( !(u >= 0) || u >= ephemeris->segments )
+		return NULL;
+
+	i = (int) u;
+	*x = 2.0 * (u - i) - 1.0;
+
+	return ephemeris->data + (size_t) i * ephemeris->stride;
+}
+
+/* Clenshaw's recurrence for the sum of c[j] T_j(x) */
+static double ephemeris_clenshaw(const double *c, int n, double x)
+{
+	double	b1 = 0, b2 = 0, b,
+			x2 = 2.0 * x;
+	int		j;
+
+	for ( j = n - 1; j > 0; --j )
+	{
+		b = x2 * b1 - b2 + c[j];
+		b2 = b1;
+		b1 = b;
+	}
+
+	return x * b1 - b2 + c[0];
+}
+
+/*******************************************************************************
+	NAME:
+		ephemeris_value
+		ephemeris_solar_coordinates
+		ephemeris_nutation
+		ephemeris_illumination
+
+	PURPOSE:
+		app_solar_coordinates, nutation and simple_illumination from an
+		ephemeris opened with ephemeris_open
+
+	INPUT ARGUMENTS:
+		*ephemeris (aaEphemeris)
+			the open ephemeris, or NULL for the series
+		JD (double)
+			Julian Day TD, UT for ephemeris_solar_coordinates and
+			ephemeris_illumination when aa_set_auto_delta_t() is on as
+			app_solar_coordinates and simple_illumination take it
+		T (double)
+			Julian centuries TD for ephemeris_nutation
+		quantity (EphemerisQuantities)
+			what ephemeris_value returns
+
+	OUTPUT ARGUMENTS:
+		*value (double)
+			the quantity, unchanged when not covered
+		*alpha, *delta, *deltaPsi, *deltaEpsilon (double)
+			as app_solar_coordinates and nutation
+
+	RETURNED VALUE:
+		ephemeris_value: 1 if the file covers JD, 0 if not
+		ephemeris_illumination: illuminated fraction of the moon's disc
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		app_solar_coordinates, nutation, simple_illumination, ut_to_tt,
+		aa_get_auto_delta_t, nutation_get_model, aa_get_tolerance, Revolution
+
+	NOTES:
+		A query is a division for the segment and a Clenshaw recurrence of
+		degree + 1 steps per quantity, the same cost for any date.  Outside
+		the file, or without one, the three functions fall back to the
+		series and give what the functions they stand for do.
+		ephemeris_nutation also falls back when the nutation model or the
+		aa_set_tolerance() angle tolerance is not the one the file was
+		compiled with, ephemeris_value returns the file's values regardless.
+
+********************************************************************************/
+int ephemeris_value(const aaEphemeris *ephemeris, double JD, EphemerisQuantities quantity, double *value)
+{
+	const double	*segment;
+	double			x;
+
+	if ( (int) quantity < 0 || (int) quantity >= eph_count || (segment = ephemeris_segment(ephemeris, JD, &x)) == NULL )
+		return 0;
+
+	*value = ephemeris_clenshaw(segment + quantity * ephemeris->coefficients, ephemeris->coefficients, x);
+
+	if ( quantity == eph_alpha )
+		*value = Revolution(*value);
+
+	return 1;
+}
+
+void ephemeris_solar_coordinates(const aaEphemeris *ephemeris, double JD, double *alpha, double *delta)
+{
+	const double	*segment;
+	double			x, JDE = aa_get_auto_delta_t() ? ut_to_tt(JD) : JD;
+	int				n;
+
+	if ( (segment = ephemeris_segment(ephemeris, JDE, &x)) == NULL )
+	{
+		app_solar_coordinates(JD, alpha, delta);
+		return;
+	}
+
+	n = ephemeris->coefficients;
+	*alpha = Revolution(ephemeris_clenshaw(segment + eph_alpha * n, n, x));
+	*delta = ephemeris_clenshaw(segment + eph_delta * n, n, x);
+}
+
+void ephemeris_nutation(const aaEphemeris *ephemeris, double T, double *deltaPsi, double *deltaEpsilon)
+{
+	const double	*segment = NULL;
+	double			x, arcseconds, seconds;
+	int				n;
+
+	aa_get_tolerance(&arcseconds, &seconds);
+
+	/* a file of another model or tolerance is not what nutation gives now */
+	if ( ephemeris != NULL && ephemeris->model == nutation_get_model() && ephemeris->tolerance == arcseconds )
+		segment = ephemeris_segment(ephemeris, 2451545.0 + T * 36525.0, &x);
+
+	if ( segment == NULL )
+	{
+		nutation(T, deltaPsi, deltaEpsilon);
+		return;
+	}
+
+	n = ephemeris->coefficients;
+	*deltaPsi = ephemeris_clenshaw(segment + eph_delta_psi * n, n, x);
+	*deltaEpsilon = ephemeris_clenshaw(segment + eph_delta_epsilon * n, n, x);
+}
+
+double ephemeris_illumination(const aaEphemeris *ephemeris, double JD)
+{
+	double	k;
+
+	if ( !ephemeris_value(ephemeris, aa_get_auto_delta_t() ? ut_to_tt(JD) : JD, eph_illumination, &k) )
+		k = simple_illumination(JD);
+
+	return k;
+}
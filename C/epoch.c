@@ -0,0 +1,110 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+
+/* fills everything but the times and the sidereal times for T centuries TD */
+static void epoch_fill(aaEpoch *epoch, double T)
+{
+	epoch->T = T;
+	epoch->T2 = T * T;
+	epoch->T3 = epoch->T2 * T;
+	epoch->T4 = epoch->T3 * T;
+
+	/* fundamental arguments, pp. 132 and 308, as simple_illumination evaluates them */
+	epoch->D = fmod(297.8502042 + (445267.1115168 * T) - (0.0016300 * T * T)
+		+ ((T * T * T)/545868) - ((T * T * T * T)/113065000), 360.0);
+	epoch->M = fmod(357.5291092 + (35999.0502909 * T) - (0.0001536 * T * T)
+		+ ((T * T * T)/24490000), 360.0);
+	epoch->Mprime = fmod(134.9634114 + (477198.8676313 * T) + (0.0089970 * T * T)
+		+ ((T * T * T)/69699) - ((T * T * T * T)/14712000), 360.0);
+	epoch->F = fmod(93.2720993 + (483202.0175273 * T) - (0.0034029 * T * T)
+		- ((T * T * T)/3526000) + ((T * T * T * T)/863310000), 360.0);
+	epoch->omega = fmod(125.04452 - 1934.136261 * T + 0.0020708 * T * T + (T * T * T)/450000, 360.0);
+
+	nutation_obliquity(T, &epoch->deltaPsi, &epoch->deltaEpsilon, &epoch->epsilon, &epoch->epsilonNull);
+}
+
+/*******************************************************************************
+	NAME:
+		epoch_init
+		epoch_init_instant
+
+	PURPOSE:
+		Computes once the quantities of an instant that the _ctx functions
+		share: Julian centuries and their powers, the fundamental arguments,
+		nutation, obliquity and sidereal time
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 83-84, 131-136, 308
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day UT
+		t (aaInstant)
+			instant UT
+
+	OUTPUT ARGUMENTS:
+		*epoch (aaEpoch)
+			the quantities, see astroalgo.h
+
+	RETURNED VALUE:
+		none
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		julian_centuries, nutation_obliquity, mean_sidereal_time,
+		mean_sidereal_time_instant, ut_to_tt, delta_t, aa_get_auto_delta_t,
+		SinCosD, fmod
+
+	NOTES:
+		JDE is JD + DeltaT when aa_set_auto_delta_t() is on, JD otherwise as
+		everywhere else in the library.  Either way every field is bit for
+		bit what the functions computing it on their own give, theta is
+		app_sidereal_time(JD) and epsilon is obliquity(T).
+
+		The fundamental arguments are those of the lunar theory, pp. 308,
+		reduced to -360..360 degrees.  The solar theory, pp. 151-152, has its
+		own M and omega, about 2e-5 and 7e-3 degrees from these over 1900 -
+		2100, so app_solar_coordinates_ctx takes only T from the epoch.
+
+********************************************************************************/
+void epoch_init(aaEpoch *epoch, double JD)
+{
+	double	sinEpsilon, cosEpsilon;
+
+	epoch->JD = JD;
+	epoch->JDE = aa_get_auto_delta_t() ? ut_to_tt(JD) : JD;
+
+	epoch_fill(epoch, julian_centuries(epoch->JDE));
+
+	epoch->theta0 = mean_sidereal_time(JD);
+	SinCosD(epoch->epsilon, &sinEpsilon, &cosEpsilon);
+	epoch->theta = epoch->theta0 + epoch->deltaPsi / 15.0 * cosEpsilon / 240.0;
+}
+
+void epoch_init_instant(aaEpoch *epoch, aaInstant t)
+{
+	double	T = instant_centuries(t),		/* no digits lost to the Julian Day */
+			sinEpsilon, cosEpsilon;
+
+	epoch->JD = instant_to_julian(t);
+	epoch->JDE = epoch->JD;
+
+	if ( aa_get_auto_delta_t() )
+	{
+		T += delta_t(epoch->JD) / (86400.0 * 36525.0);
+		epoch->JDE = ut_to_tt(epoch->JD);
+	}
+
+	epoch_fill(epoch, T);
+
+	epoch->theta0 = mean_sidereal_time_instant(t);
+	SinCosD(epoch->epsilon, &sinEpsilon, &cosEpsilon);
+	epoch->theta = epoch->theta0 + epoch->deltaPsi / 15.0 * cosEpsilon / 240.0;
+}
@@ -4,6 +4,35 @@
 /* C Headers */
 #include <math.h>
 
+/* periodic terms A * cos(B + C * T) of table 26.C, sorted by amplitude */
+static const double equinox_terms[24][3] =
+{
+	{485,	324.96,	  1934.136},
+	{203,	337.23,	 32964.467},
+	{199,	342.08,	    20.186},
+	{182,	 27.85,	445267.112},
+	{156,	 73.14,	 45036.886},
+	{136,	171.52,	 22518.443},
+	{ 77,	222.54,	 65928.934},
+	{ 74,	296.72,	  3034.906},
+	{ 70,	243.58,	  9037.513},
+	{ 58,	119.81,	 33718.147},
+	{ 52,	297.17,	   150.678},
+	{ 50,	 21.02,	  2281.226},
+	{ 45,	247.54,	 29929.562},
+	{ 44,	325.15,	 31555.956},
+	{ 29,	 60.93,	  4443.417},
+	{ 28,	155.12,	 67555.328},
+	{ 17,	288.79,	  4562.452},
+	{ 16,	198.04,	 62894.029},
+	{ 14,	199.76,	 31436.921},
+	{ 12,	 95.39,	 14577.848},
+	{ 12,	287.11,	 31931.756},
+	{ 12,	320.81,	 34777.259},
+	{  9,	227.73,	  1222.114},
+	{  8,	 15.45,	 16859.074}
+};
+
 /* ---------------------------------------------------------------------------------
 	NAME:
 		EquinoxSolstice
@@ -30,7 +59,7 @@
 	 	none
 	 
 	FUNCTIONS CALLED:
-		none
+		equinox_solstice_tol, aa_get_tolerance
 	 
 	DATE/PROGRAMMER/NOTE:
 	 	06-16-1998	Todd A. Guillory	created
@@ -38,13 +67,60 @@
 	
 ----------------------------------------------------------------------------------*/
 double equinox_solstice( double inYear, unsigned short inES )
+{
+	double	arcseconds,		/* angle tolerance */
+			seconds;		/* time tolerance */
+	
+	aa_get_tolerance(&arcseconds, &seconds);
+	
+	return equinox_solstice_tol(inYear, inES, seconds);
+}
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		equinox_solstice_tol
+		
+	PURPOSE:
+		Compute the Julian Day for the Equinox and Solstice using only the largest
+		periodic terms needed to meet a tolerance
+				
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 165-167
+			
+	INPUT ARGUMENTS:
+		inYear (double)
+			year to compute event in
+		inES (unsigned short)
+			event: 0 march equinox, 1 june solstice, 2 september equinox, 3 december solstice
+		tolerance (double)
+			largest error allowed from dropped terms in seconds of time, 0 for all terms
+	
+	OUTPUT ARGUMENTS:
+	 	none
+	 
+	RETURNED VALUE:
+	 	closest Julian Day event occurs
+	 
+	GLOBALS USED:
+	 	equinox_terms
+	 
+	FUNCTIONS CALLED:
+		CosD, cos, floor
+	
+----------------------------------------------------------------------------------*/
+double equinox_solstice_tol( double inYear, unsigned short inES, double tolerance )
 {
 	double	y,
 			jden,		/* Julian Ephemeris Day */
 			T,			/* Julian Centuries */
 			W,
 			lambda,
-			S;			/* sum of periodic terms */
+			S,			/* sum of periodic terms */
+			budget;		/* tolerance left for dropped terms */
+	int		count = 24,	/* periodic terms evaluated */
+			i;
 	  
 	if ( inYear >= 1000 )
     {
@@ -83,30 +159,18 @@ double equinox_solstice( double inYear, unsigned short inES )
 	
 	lambda = 1 + 0.0334 * CosD(W) + 0.0007 * CosD(2*W);
 
-	S = 485 * cos(kDegRad*324.96 + kDegRad*(  1934.136 * T))
-			+ 203 * cos(kDegRad*337.23 + kDegRad*( 32964.467 * T))
-			+ 199 * cos(kDegRad*342.08 + kDegRad*(    20.186 * T))
-			+ 182 * cos(kDegRad* 27.85 + kDegRad*(445267.112 * T))
-			+ 156 * cos(kDegRad* 73.14 + kDegRad*( 45036.886 * T))
-			+ 136 * cos(kDegRad*171.52 + kDegRad*( 22518.443 * T))
-			+  77 * cos(kDegRad*222.54 + kDegRad*( 65928.934 * T))
-			+  74 * cos(kDegRad*296.72 + kDegRad*(  3034.906 * T))
-			+  70 * cos(kDegRad*243.58 + kDegRad*(  9037.513 * T))
-			+  58 * cos(kDegRad*119.81 + kDegRad*( 33718.147 * T))
-			+  52 * cos(kDegRad*297.17 + kDegRad*(   150.678 * T))
-			+  50 * cos(kDegRad* 21.02 + kDegRad*(  2281.226 * T))
-			+  45 * cos(kDegRad*247.54 + kDegRad*( 29929.562 * T))
-			+  44 * cos(kDegRad*325.15 + kDegRad*( 31555.956 * T))
-			+  29 * cos(kDegRad* 60.93 + kDegRad*(  4443.417 * T))
-			+  28 * cos(kDegRad*155.12 + kDegRad*( 67555.328 * T))
-			+  17 * cos(kDegRad*288.79 + kDegRad*(  4562.452 * T))
-			+  16 * cos(kDegRad*198.04 + kDegRad*( 62894.029 * T))
-			+  14 * cos(kDegRad*199.76 + kDegRad*( 31436.921 * T))
-			+  12 * cos(kDegRad* 95.39 + kDegRad*( 14577.848 * T))
-			+  12 * cos(kDegRad*287.11 + kDegRad*( 31931.756 * T))
-			+  12 * cos(kDegRad*320.81 + kDegRad*( 34777.259 * T))
-			+   9 * cos(kDegRad*227.73 + kDegRad*(  1222.114 * T))
-			+   8 * cos(kDegRad* 15.45 + kDegRad*( 16859.074 * T));
+	/* drop the smallest terms that fit in the tolerance, S is scaled by 0.00001 / lambda days */
+	if ( tolerance > 0 )
+	{
+		budget = tolerance / 86400.0 * lambda / 0.00001;
+		
+		while ( count > 0 && equinox_terms[count - 1][0] <= budget )
+			budget -= equinox_terms[--count][0];
+	}
+	
+	S = 0;
+	for ( i = 0; i < count; ++i )
+		S += equinox_terms[i][0] * cos(kDegRad*equinox_terms[i][1] + kDegRad*(equinox_terms[i][2] * T));
 			
 	return ( jden + (0.00001*S/lambda) );
   
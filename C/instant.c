@@ -0,0 +1,153 @@
+#include "astroalgo.h"
+
+/* C Headers */
+#include <math.h>
+
+/* Julian Day of J2000.0, the origin of aaInstant, 2000 January 1 12h */
+#define J2000_JD			2451545.0
+
+/* nanoseconds in a day */
+#define NS_PER_DAY			86400000000000LL
+
+/*******************************************************************************
+	NAME:
+		julian_to_instant
+		instant_to_julian
+		unix_to_instant
+
+	PURPOSE:
+		Conversions between Julian Days, Unix time and aaInstant
+
+	REFERENCES:
+		none
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day
+		t (aaInstant)
+			instant
+		seconds (long long), nanoseconds (long)
+			Unix time, seconds since 1970-01-01T00:00:00Z plus nanoseconds,
+			either may be negative
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		the instant, or its Julian Day
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		floor, instant_add
+
+	NOTES:
+		julian_to_instant rounds to the nearest nanosecond, but a Julian Day
+		near 2.45e6 only resolves about 40 microseconds, so build instants
+		from Unix time or with instant_add when the time is known better.
+		instant_to_julian rounds the instant to the same resolution.
+
+********************************************************************************/
+aaInstant julian_to_instant(double JD)
+{
+	double		d = JD - J2000_JD;			/* exact for JD 1.2e6 - 4.9e6 */
+	double		day = floor(d);
+	aaInstant	t;
+
+	t.day = (long long) day;
+	t.ns = (long long) ( (d - day) * (double) NS_PER_DAY + 0.5 );
+
+	if ( t.ns >= NS_PER_DAY )
+	{
+		++t.day;
+		t.ns -= NS_PER_DAY;
+	}
+
+	return t;
+}
+
+double instant_to_julian(aaInstant t)
+{
+	return J2000_JD + ( (double) t.day + (double) t.ns / (double) NS_PER_DAY );
+}
+
+aaInstant unix_to_instant(long long seconds, long nanoseconds)
+{
+	/* the Unix epoch, JD 2440587.5, is 10957.5 days before J2000.0 */
+	aaInstant	epoch = { -10958, NS_PER_DAY / 2 };
+	long long	days = seconds / 86400 - ( seconds % 86400 < 0 );
+
+	return instant_add(epoch, days, (seconds - days * 86400) * 1000000000LL + nanoseconds);
+}
+
+/*******************************************************************************
+	NAME:
+		instant_add
+		instant_diff
+		instant_centuries
+
+	PURPOSE:
+		Exact arithmetic on instants
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 131 for T
+
+	INPUT ARGUMENTS:
+		t, a, b (aaInstant)
+			instants
+		days (long long)
+			whole days to add, may be negative
+		ns (long long)
+			nanoseconds to add, may be negative and more than a day
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		instant_add: t + days + ns
+		instant_diff: a - b in nanoseconds
+		instant_centuries: Julian centuries from J2000.0, as julian_centuries
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		none
+
+	NOTES:
+		instant_add and instant_diff are integer only and exact.  The
+		difference must be within +/-292 years to fit 64 bits.
+		instant_centuries sums the day and its fraction from J2000.0 so no
+		digits are lost to the 2451545 of the Julian Day.
+
+********************************************************************************/
+aaInstant instant_add(aaInstant t, long long days, long long ns)
+{
+	t.day += days + ns / NS_PER_DAY;
+	t.ns += ns % NS_PER_DAY;
+
+	if ( t.ns < 0 )
+	{
+		--t.day;
+		t.ns += NS_PER_DAY;
+	}
+	else if ( t.ns >= NS_PER_DAY )
+	{
+		++t.day;
+		t.ns -= NS_PER_DAY;
+	}
+
+	return t;
+}
+
+long long instant_diff(aaInstant a, aaInstant b)
+{
+	return (a.day - b.day) * NS_PER_DAY + (a.ns - b.ns);
+}
+
+double instant_centuries(aaInstant t)
+{
+	return ( (double) t.day + (double) t.ns / (double) NS_PER_DAY ) / 36525.0;
+}
@@ -4,6 +4,125 @@
 /* C Headers */
 #include <math.h>
 
+/* one periodic correction term, coef * E^epow * sin(arg[0]*M + arg[1]*M' + arg[2]*F + arg[3]*omega) */
+typedef struct
+{
+	double		coef;		/* amplitude in days */
+	int			epow;		/* power of the eccentricity E */
+	signed char	arg[4];		/* multiples of M, M', F and omega */
+} MoonphaseTerm;
+
+/* corrections for the new moon, pg. 321, sorted by amplitude */
+static const MoonphaseTerm newmoon_terms[] =
+{
+	{-0.40720,	0,	{ 0, 1, 0, 0}},
+	{ 0.17241,	1,	{ 1, 0, 0, 0}},
+	{ 0.01608,	0,	{ 0, 2, 0, 0}},
+	{ 0.01039,	0,	{ 0, 0, 2, 0}},
+	{ 0.00739,	1,	{-1, 1, 0, 0}},
+	{-0.00514,	1,	{ 1, 1, 0, 0}},
+	{ 0.00208,	2,	{ 2, 0, 0, 0}},
+	{-0.00111,	0,	{ 0, 1,-2, 0}},
+	{-0.00057,	0,	{ 0, 1, 2, 0}},
+	{ 0.00056,	1,	{ 1, 2, 0, 0}},
+	{-0.00042,	0,	{ 0, 3, 0, 0}},
+	{ 0.00042,	1,	{ 1, 0, 2, 0}},
+	{ 0.00038,	1,	{ 1, 0,-2, 0}},
+	{-0.00024,	1,	{-1, 2, 0, 0}},
+	{-0.00017,	0,	{ 0, 0, 0, 1}},
+	{-0.00007,	0,	{ 2, 1, 0, 0}},
+	{ 0.00004,	0,	{ 0, 2,-2, 0}},
+	{ 0.00004,	0,	{ 3, 0, 0, 0}},
+	{ 0.00003,	0,	{ 1, 1,-2, 0}},
+	{ 0.00003,	0,	{ 0, 2, 2, 0}},
+	{-0.00003,	0,	{ 1, 1, 2, 0}},
+	{ 0.00003,	0,	{-1, 1, 2, 0}},
+	{-0.00002,	0,	{-1, 1,-2, 0}},
+	{-0.00002,	0,	{ 1, 3, 0, 0}},
+	{ 0.00002,	0,	{ 0, 4, 0, 0}}
+};
+
+/* corrections for the full moon, pg. 321, sorted by amplitude */
+static const MoonphaseTerm fullmoon_terms[] =
+{
+	{-0.40614,	0,	{ 0, 1, 0, 0}},
+	{ 0.17302,	1,	{ 1, 0, 0, 0}},
+	{ 0.01614,	0,	{ 0, 2, 0, 0}},
+	{ 0.01043,	0,	{ 0, 0, 2, 0}},
+	{ 0.00734,	1,	{-1, 1, 0, 0}},
+	{-0.00515,	1,	{ 1, 1, 0, 0}},
+	{ 0.00209,	2,	{ 2, 0, 0, 0}},
+	{-0.00111,	0,	{ 0, 1,-2, 0}},
+	{-0.00057,	0,	{ 0, 1, 2, 0}},
+	{ 0.00056,	1,	{ 1, 2, 0, 0}},
+	{-0.00042,	0,	{ 0, 3, 0, 0}},
+	{ 0.00042,	1,	{ 1, 0, 2, 0}},
+	{ 0.00038,	1,	{ 1, 0,-2, 0}},
+	{-0.00024,	1,	{-1, 2, 0, 0}},
+	{-0.00017,	0,	{ 0, 0, 0, 1}},
+	{-0.00007,	0,	{ 2, 1, 0, 0}},
+	{ 0.00004,	0,	{ 0, 2,-2, 0}},
+	{ 0.00004,	0,	{ 3, 0, 0, 0}},
+	{ 0.00003,	0,	{ 1, 1,-2, 0}},
+	{ 0.00003,	0,	{ 0, 2, 2, 0}},
+	{-0.00003,	0,	{ 1, 1, 2, 0}},
+	{ 0.00003,	0,	{-1, 1, 2, 0}},
+	{-0.00002,	0,	{-1, 1,-2, 0}},
+	{-0.00002,	0,	{ 1, 3, 0, 0}},
+	{ 0.00002,	0,	{ 0, 4, 0, 0}}
+};
+
+/* corrections for the first and last quarters, pg. 321, sorted by amplitude */
+static const MoonphaseTerm quarter_terms[] =
+{
+	{-0.62801,	0,	{ 0, 1, 0, 0}},
+	{ 0.17172,	1,	{ 1, 0, 0, 0}},
+	{-0.01183,	1,	{ 1, 1, 0, 0}},
+	{ 0.00862,	0,	{ 0, 2, 0, 0}},
+	{ 0.00804,	0,	{ 0, 0, 2, 0}},
+	{ 0.00454,	1,	{-1, 1, 0, 0}},
+	{ 0.00204,	2,	{ 2, 0, 0, 0}},
+	{-0.00180,	0,	{ 0, 1,-2, 0}},
+	{-0.00070,	0,	{ 0, 1, 2, 0}},
+	{-0.00040,	0,	{ 0, 3, 0, 0}},
+	{-0.00034,	1,	{-1, 2, 0, 0}},
+	{ 0.00032,	1,	{ 1, 0, 2, 0}},
+	{ 0.00032,	1,	{ 1, 0,-2, 0}},
+	{-0.00028,	2,	{ 2, 1, 0, 0}},
+	{ 0.00027,	1,	{ 1, 2, 0, 0}},
+	{-0.00017,	0,	{ 0, 0, 0, 1}},
+	{-0.00005,	0,	{-1, 1,-2, 0}},
+	{ 0.00004,	0,	{ 0, 2, 2, 0}},
+	{-0.00004,	0,	{ 1, 1, 2, 0}},
+	{ 0.00004,	0,	{-2, 1, 0, 0}},
+	{ 0.00003,	0,	{ 1, 1,-2, 0}},
+	{ 0.00003,	0,	{ 3, 0, 0, 0}},
+	{ 0.00002,	0,	{ 0, 2,-2, 0}},
+	{ 0.00002,	0,	{-1, 1, 2, 0}},
+	{-0.00002,	0,	{ 1, 3, 0, 0}}
+};
+
+#define MOON_TERMS		(sizeof(newmoon_terms) / sizeof(newmoon_terms[0]))
+
+/* planetary arguments A = B + C * k + D * t^2 in degrees with amplitudes in 0.000001 day, pg. 321 */
+static const double planetary_terms[14][4] =
+{
+	{325,	299.77,	 0.107408,	-0.009173},
+	{165,	251.88,	 0.016321,	0},
+	{164,	251.83,	26.651886,	0},
+	{126,	349.42,	36.412478,	0},
+	{110,	 84.66,	18.206239,	0},
+	{ 62,	141.74,	53.303771,	0},
+	{ 60,	207.14,	 2.453732,	0},
+	{ 56,	154.84,	 7.306860,	0},
+	{ 47,	 34.52,	27.261239,	0},
+	{ 42,	207.19,	 0.121824,	0},
+	{ 40,	291.34,	 1.844379,	0},
+	{ 37,	161.72,	24.198154,	0},
+	{ 35,	239.56,	25.513099,	0},
+	{ 23,	331.55,	 3.592518,	0}
+};
+
 /* ---------------------------------------------------------------------------------
 	NAME:
 		Moonphase
@@ -31,7 +150,7 @@
 	 	none
 	 
 	FUNCTIONS CALLED:
-		none
+		moonphase_tol, aa_get_tolerance
 	 
 	DATE/PROGRAMMER/NOTE:
 	 	06-16-1998	Todd A. Guillory	created
@@ -41,17 +160,84 @@
 ----------------------------------------------------------------------------------*/
 double moonphase(double year, Moonphases phase)
 {
+	double	arcseconds,		/* angle tolerance */
+			seconds;		/* time tolerance */
+	
+	aa_get_tolerance(&arcseconds, &seconds);
+	
+	return moonphase_tol(year, phase, seconds);
+}
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		moonphase_tol
+		
+	PURPOSE:
+		Calculate Julian Day a given input phase occurs on using only the largest
+		periodic terms needed to meet a tolerance
+				
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pg. 319 - 324
+			
+	INPUT ARGUMENTS:
+		year (double)
+			year to compute phase on, day and time are fractions of the year
+		phase (Moonphases)
+			phase to compute
+		tolerance (double)
+			largest error allowed from dropped terms in seconds of time, 0 for all terms
+	
+	OUTPUT ARGUMENTS:
+	 	none
+	 
+	RETURNED VALUE:
+	 	Julian Day (double) that phase occurs on closest to the input day
+	 
+	GLOBALS USED:
+	 	newmoon_terms, fullmoon_terms, quarter_terms, planetary_terms
+	 
+	FUNCTIONS CALLED:
+		sin, cos, floor, pow, fabs
+	 
+	NOTES:
+		The correction and planetary tables are both sorted by amplitude, terms
+		are dropped from whichever tail is smaller for as long as the sum of the
+		dropped amplitudes stays within the tolerance.  The quarter phase
+		corrections W are always applied.
+	
+----------------------------------------------------------------------------------*/
+double moonphase_tol(double year, Moonphases phase, double tolerance)
+{
+	const MoonphaseTerm	*term;			/* corrections for the phase */
 	double	k = 0;
 	double	t = 0;				/* time in Julian centuries */
-	double	m = 0;				/* Sun's mean anomaly */
-	double	mprime = 0;			/* Moon's mean anomaly */
-	double	f = 0;				/* Moon's argument of latitude */
-	double	omega = 0;			/* Longitude of the ascending node of the lunar orbit */
+	double	arg[4];				/* M, M', F and omega in radians */
+	double	epow[3];			/* powers of E */
 	double	w = 0;				/* quarter phase corrections */
-	double	a[14] = {0};		/* planatary arguments */
 	double	atotal = 0;			/* sum of planatary arguments */
 	double	corrections = 0;	/* sum of corrections */
 	double	e = 0;				/* eccentricity of Earth's orbit */
+	int		ncorr = MOON_TERMS;	/* corrections evaluated */
+	int		nplan = 14;			/* planetary arguments evaluated */
+	int		i;
+	
+	switch (phase)
+	{
+		case (newmoon):
+			term = newmoon_terms;
+			break;
+		case (fullmoon):
+			term = fullmoon_terms;
+			break;
+		case (firstquarter):
+		case (lastquarter):
+			term = quarter_terms;
+			break;
+		default:
+			return -1.0;
+	}
 	
 	k = floor((year - 2000.0) * 12.3685) + ((double)phase * 0.25);
 	
@@ -59,147 +245,57 @@ double moonphase(double year, Moonphases phase)
 	
 	e = 1.0 - t * ( 0.002516 - ( 0.0000074 * t)); /* pg 308 */
 	
-	m = kDegRad * (2.5534 + (29.10535669 * k) - t * t * ( 0.0000218  - (0.00000011 * t )));
-	
-	mprime = kDegRad * (201.5643 + (385.81693528 * k) + t * t * ( 0.0107438 + (0.00001239 * t) - (0.000000058 * t * t)));
-	
-	f = kDegRad * (160.7108 + (390.67050274 * k) + t * t * ( 0.0016341  + (0.00000227 * t) - (0.000000011 * t * t)));
-	
-	omega = kDegRad * (124.7746 - (1.56375580 * k) + t * t * ( 0.0020691 + (0.00000215 * t)));
-	
-	a[0] =  kDegRad * (299.77 + (0.107408  * k) - (0.009173 * t * t));
-	a[1] =  kDegRad * (251.88 + (0.016321  * k));
-	a[2] =  kDegRad * (251.83 + (26.651886 * k));
-	a[3] =  kDegRad * (349.42 + (36.412478 * k));
-	a[4] =  kDegRad * (84.66  + (18.206239 * k));
-	a[5] =  kDegRad * (141.74 + (53.303771 * k));
-	a[6] =  kDegRad * (207.14 + (2.453732  * k));
-	a[7] =  kDegRad * (154.84 + (7.306860  * k));
-	a[8] =  kDegRad * (34.52  + (27.261239 * k));
-	a[9] = kDegRad * (207.19 + (0.121824  * k));
-	a[10] = kDegRad * (291.34 + (1.844379  * k));
-	a[11] = kDegRad * (161.72 + (24.198154 * k));
-	a[12] = kDegRad * (239.56 + (25.513099 * k));
-	a[13] = kDegRad * (331.55 + (3.592518  * k));
-	
-	atotal = .000001 * ((325 * sin(a[0])) 
-				+  (165 * sin(a[1])) 
-				+  (164 * sin(a[2])) 
-				+  (126 * sin(a[3])) 
-				+  (110 * sin(a[4])) 
-				+  ( 62 * sin(a[5])) 
-				+  ( 60 * sin(a[6])) 
-				+  ( 56 * sin(a[7])) 
-				+  ( 47 * sin(a[8])) 
-				+  ( 42 * sin(a[9])) 
-				+  ( 40 * sin(a[10])) 
-				+  ( 37 * sin(a[11])) 
-				+  ( 35 * sin(a[12])) 
-				+  ( 23 * sin(a[13])));
+	epow[0] = 1;
+	epow[1] = e;
+	epow[2] = e * e;
 	
-	switch (phase)
-	{	
-		case (newmoon):
+	/* Sun's mean anomaly */
+	arg[0] = kDegRad * (2.5534 + (29.10535669 * k) - t * t * ( 0.0000218  - (0.00000011 * t )));
+	
+	/* Moon's mean anomaly */
+	arg[1] = kDegRad * (201.5643 + (385.81693528 * k) + t * t * ( 0.0107438 + (0.00001239 * t) - (0.000000058 * t * t)));
+	
+	/* Moon's argument of latitude */
+	arg[2] = kDegRad * (160.7108 + (390.67050274 * k) + t * t * ( 0.0016341  + (0.00000227 * t) - (0.000000011 * t * t)));
+	
+	/* Longitude of the ascending node of the lunar orbit */
+	arg[3] = kDegRad * (124.7746 - (1.56375580 * k) + t * t * ( 0.0020691 + (0.00000215 * t)));
+	
+	/* drop the smallest corrections and planetary terms that fit in the tolerance */
+	if ( tolerance > 0 )
+	{
+		double	budget = tolerance / 86400.0,
+				c, p;
+		
+		for ( ;; )
 		{
-			corrections = - (0.40720 *		sin(mprime)) 
-						+ (0.17241 * e *	sin(m)) 
-						+ (0.01608 *		sin(2*mprime)) 
-						+ (0.01039 *		sin(2 * f)) 
-						+ (0.00739 * e *      sin(mprime - m)) 
-						- (0.00514 * e *      sin(mprime + m)) 
-						+ (0.00208 * e * e *  sin(2 * m)) 
-						- (0.00111 *          sin(mprime - 2 * f)) 
-						- (0.00057 *          sin(mprime + 2 * f)) 
-						+ (0.00056 * e *      sin(2 * mprime + m)) 
-						- (0.00042 *          sin(3 * mprime)) 
-						+ (0.00042 * e *      sin(m + 2 * f)) 
-						+ (0.00038 * e *      sin(m - 2 * f)) 
-						- (0.00024 * e *      sin(2 * mprime - m)) 
-						- (0.00017 *          sin(omega)) 
-						- (0.00007 *          sin(mprime + 2 * m)) 
-						+ (0.00004 *          sin(2 * mprime - 2 * f)) 
-						+ (0.00004 *          sin(3 * m)) 
-						+ (0.00003 *          sin(mprime + m - 2 * f)) 
-						+ (0.00003 *          sin(2 * mprime + 2 * f)) 
-						- (0.00003 *          sin(mprime + m + 2 * f)) 
-						+ (0.00003 *          sin(mprime - m + 2 * f)) 
-						- (0.00002 *          sin(mprime - m - 2 * f)) 
-						- (0.00002 *          sin(3 * mprime + m)) 
-						+ (0.00002 *          sin(4 * mprime));
-			break;
+			c = ( ncorr > 0 ) ? fabs(term[ncorr - 1].coef) * epow[term[ncorr - 1].epow] : budget + 1;
+			p = ( nplan > 0 ) ? 0.000001 * planetary_terms[nplan - 1][0] : budget + 1;
+			
+			if ( c <= p && c <= budget )
+				{ budget -= c; --ncorr; }
+			else if ( p < c && p <= budget )
+				{ budget -= p; --nplan; }
+			else
+				break;
 		}
-
-    case (fullmoon) :
-    	{
-  		corrections = - (0.40614 *         sin(mprime)) 
-                  + (0.17302 * e *     sin(m)) 
-                  + (0.01614 *         sin(2*mprime)) 
-                  + (0.01043 *         sin(2 * f)) 
-                  + (0.00734 * e *     sin(mprime - m)) 
-                  - (0.00515 * e *     sin(mprime + m)) 
-                  + (0.00209 * e * e * sin(2 * m)) 
-                  - (0.00111 *         sin(mprime - 2 * f)) 
-                  - (0.00057 *         sin(mprime + 2 * f)) 
-                  + (0.00056 * e *     sin(2 * mprime + m)) 
-                  - (0.00042 *         sin(3 * mprime)) 
-                  + (0.00042 * e *     sin(m + 2 * f)) 
-                  + (0.00038 * e *     sin(m - 2 * f)) 
-                  - (0.00024 * e *     sin(2 * mprime - m)) 
-                  - (0.00017 *         sin(omega)) 
-                  - (0.00007 *         sin(mprime + 2 * m)) 
-                  + (0.00004 *         sin(2 * mprime - 2 * f)) 
-                  + (0.00004 *         sin(3 * m)) 
-                  + (0.00003 *         sin(mprime + m - 2 * f)) 
-                  + (0.00003 *         sin(2 * mprime + 2 * f)) 
-                  - (0.00003 *         sin(mprime + m + 2 * f)) 
-                  + (0.00003 *         sin(mprime - m + 2 * f)) 
-                  - (0.00002 *         sin(mprime - m - 2 * f)) 
-                  - (0.00002 *         sin(3 * mprime + m)) 
-                  + (0.00002 *         sin(4 * mprime));
-  			break;
-  		}
-  
-  	case (firstquarter):
-  	case (lastquarter):
-  	{
-  		corrections = - (0.62801 *         sin(mprime)) 
-                  + (0.17172 * e *     sin(m)) 
-                  - (0.01183 * e *     sin(mprime + m)) 
-                  + (0.00862 *         sin(2 * mprime)) 
-                  + (0.00804 *         sin(2 * f)) 
-                  + (0.00454 * e *     sin(mprime - m)) 
-                  + (0.00204 * e * e * sin(2 * m)) 
-                  - (0.00180 *         sin(mprime - 2 * f)) 
-                  - (0.00070 *         sin(mprime + 2 * f)) 
-                  - (0.00040 *         sin(3 * mprime)) 
-                  - (0.00034 * e *     sin(2 * mprime - m)) 
-                  + (0.00032 * e *     sin(m + 2 * f)) 
-                  + (0.00032 * e *     sin(m - 2 * f)) 
-                  - (0.00028 * e * e * sin(mprime + 2 * m)) 
-                  + (0.00027 * e *     sin(2 * mprime + m)) 
-                  - (0.00017 *         sin(omega)) 
-                  - (0.00005 *         sin(mprime - m - 2 * f)) 
-                  + (0.00004 *         sin(2 * mprime + 2 * f)) 
-                  - (0.00004 *         sin(mprime + m + 2 * f)) 
-                  + (0.00004 *         sin(mprime - 2 * m)) 
-                  + (0.00003 *         sin(mprime + m - 2 * f)) 
-                  + (0.00003 *         sin(3 * m)) 
-                  + (0.00002 *         sin(2 * mprime - 2 * f)) 
-                  + (0.00002 *         sin(mprime - m + 2 * f)) 
-                  - (0.00002 *         sin(3 * mprime + m));
-                 
-            w = .00306 - .00038 * e * cos(m) + .00026 * cos(mprime) - .00002 * cos(mprime - m) + .00002 * cos(mprime + m) + .00002 * cos(2*f);
-
-  			if ( phase == lastquarter )
-  				w = -w;
-  		break;
-  	}
-	
-	default:
-		return -1.0;
-	}   
-   
-  
-  return(2451550.09765 + (29.530588853 * k) + (0.0001337 * pow(t,2)) - (0.000000150 * pow(t,3)) + (0.00000000073 * pow(t,4))  + corrections + atotal + w);
-  
+	}
+	
+	for ( i = 0; i < nplan; ++i )
+		atotal += planetary_terms[i][0] * sin(kDegRad * (planetary_terms[i][1] + (planetary_terms[i][2] * k) + (planetary_terms[i][3] * t * t)));
+	atotal *= .000001;
+	
+	for ( i = 0; i < ncorr; ++i, ++term )
+		corrections += term->coef * epow[term->epow]
+					 * sin(term->arg[0] * arg[0] + term->arg[1] * arg[1] + term->arg[2] * arg[2] + term->arg[3] * arg[3]);
+	
+	if ( phase == firstquarter || phase == lastquarter )
+	{
+		w = .00306 - .00038 * e * cos(arg[0]) + .00026 * cos(arg[1]) - .00002 * cos(arg[1] - arg[0]) + .00002 * cos(arg[1] + arg[0]) + .00002 * cos(2*arg[2]);
+		
+		if ( phase == lastquarter )
+			w = -w;
+	}
+	
+	return(2451550.09765 + (29.530588853 * k) + (0.0001337 * pow(t,2)) - (0.000000150 * pow(t,3)) + (0.00000000073 * pow(t,4))  + corrections + atotal + w);
 }
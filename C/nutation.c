@@ -1,5 +1,416 @@
 #include "astroalgo.h"
 #include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+
+/* largest multiple of a fundamental argument a nutation table may use */
+#define NUT_MAXMULT		8
+
+/* arc seconds to radians */
+#define NUT_ARCSEC		(kDegRad / 3600.0)
+
+/* periodic terms for the nutation in longitude and obliquity, table 21.A pg. 133-134 */
+/* arguments are reordered to l (M'), l' (M), F, D, omega and terms sorted by amplitude */
+/* coefficients are in units of 0".0001 */
+static const aaNutationTerm meeus_terms[] =
+{
+	{{ 0, 0, 0, 0, 1},	-171996, -174.2,	 92025,   8.9,	0, 0},
+	{{ 0, 0, 2,-2, 2},	 -13187,   -1.6,	  5736,  -3.1,	0, 0},
+	{{ 0, 0, 2, 0, 2},	  -2274,   -0.2,	   977,  -0.5,	0, 0},
+	{{ 0, 0, 0, 0, 2},	   2062,    0.2,	  -895,   0.5,	0, 0},
+	{{ 0, 1, 0, 0, 0},	   1426,   -3.4,	    54,  -0.1,	0, 0},
+	{{ 1, 0, 0, 0, 0},	    712,    0.1,	    -7,     0,	0, 0},
+	{{ 0, 1, 2,-2, 2},	   -517,    1.2,	   224,  -0.6,	0, 0},
+	{{ 0, 0, 2, 0, 1},	   -386,   -0.4,	   200,     0,	0, 0},
+	{{ 1, 0, 2, 0, 2},	   -301,      0,	   129,  -0.1,	0, 0},
+	{{ 0,-1, 2,-2, 2},	    217,   -0.5,	   -95,   0.3,	0, 0},
+	{{ 1, 0, 0,-2, 0},	   -158,      0,	     0,     0,	0, 0},
+	{{ 0, 0, 2,-2, 1},	    129,    0.1,	   -70,     0,	0, 0},
+	{{-1, 0, 2, 0, 2},	    123,      0,	   -53,     0,	0, 0},
+	{{ 1, 0, 0, 0, 1},	     63,    0.1,	   -33,     0,	0, 0},
+	{{ 0, 0, 0, 2, 0},	     63,      0,	     0,     0,	0, 0},
+	{{-1, 0, 2, 2, 2},	    -59,      0,	    26,     0,	0, 0},
+	{{-1, 0, 0, 0, 1},	    -58,   -0.1,	    32,     0,	0, 0},
+	{{ 1, 0, 2, 0, 1},	    -51,      0,	    27,     0,	0, 0},
+	{{ 2, 0, 0,-2, 0},	     48,      0,	     0,     0,	0, 0},
+	{{-2, 0, 2, 0, 1},	     46,      0,	   -24,     0,	0, 0},
+	{{ 0, 0, 2, 2, 2},	    -38,      0,	    16,     0,	0, 0},
+	{{ 2, 0, 2, 0, 2},	    -31,      0,	    13,     0,	0, 0},
+	{{ 2, 0, 0, 0, 0},	     29,      0,	     0,     0,	0, 0},
+	{{ 1, 0, 2,-2, 2},	     29,      0,	   -12,     0,	0, 0},
+	{{ 0, 0, 2, 0, 0},	     26,      0,	     0,     0,	0, 0},
+	{{ 0, 0, 2,-2, 0},	    -22,      0,	     0,     0,	0, 0},
+	{{-1, 0, 2, 0, 1},	     21,      0,	   -10,     0,	0, 0},
+	{{ 0, 2, 0, 0, 0},	     17,   -0.1,	     0,     0,	0, 0},
+	{{ 0, 2, 2,-2, 2},	    -16,    0.1,	     7,     0,	0, 0},
+	{{-1, 0, 0, 2, 1},	     16,      0,	    -8,     0,	0, 0},
+	{{ 0, 1, 0, 0, 1},	    -15,      0,	     9,     0,	0, 0},
+	{{ 1, 0, 0,-2, 1},	    -13,      0,	     7,     0,	0, 0},
+	{{ 0,-1, 0, 0, 1},	    -12,      0,	     6,     0,	0, 0},
+	{{ 2, 0,-2, 0, 0},	     11,      0,	     0,     0,	0, 0},
+	{{-1, 0, 2, 2, 1},	    -10,      0,	     5,     0,	0, 0},
+	{{ 1, 0, 2, 2, 2},	     -8,      0,	     3,     0,	0, 0},
+	{{ 0, 1, 2, 0, 2},	      7,      0,	    -3,     0,	0, 0},
+	{{ 1, 1, 0,-2, 0},	     -7,      0,	     0,     0,	0, 0},
+	{{ 0,-1, 2, 0, 2},	     -7,      0,	     3,     0,	0, 0},
+	{{ 0, 0, 2, 2, 1},	     -7,      0,	     3,     0,	0, 0},
+	{{ 1, 0, 0, 2, 0},	      6,      0,	     0,     0,	0, 0},
+	{{ 2, 0, 2,-2, 2},	      6,      0,	    -3,     0,	0, 0},
+	{{ 1, 0, 2,-2, 1},	      6,      0,	    -3,     0,	0, 0},
+	{{-2, 0, 0, 2, 1},	     -6,      0,	     3,     0,	0, 0},
+	{{ 0, 0, 0, 2, 1},	     -6,      0,	     3,     0,	0, 0},
+	{{ 1,-1, 0, 0, 0},	      5,      0,	     0,     0,	0, 0},
+	{{ 0,-1, 2,-2, 1},	     -5,      0,	     3,     0,	0, 0},
+	{{ 0, 0, 0,-2, 1},	     -5,      0,	     3,     0,	0, 0},
+	{{ 2, 0, 2, 0, 1},	     -5,      0,	     3,     0,	0, 0},
+	{{ 2, 0, 0,-2, 1},	      4,      0,	     0,     0,	0, 0},
+	{{ 0, 1, 2,-2, 1},	      4,      0,	     0,     0,	0, 0},
+	{{ 1, 0,-2, 0, 0},	      4,      0,	     0,     0,	0, 0},
+	{{ 1, 0, 0,-1, 0},	     -4,      0,	     0,     0,	0, 0},
+	{{ 0, 1, 0,-2, 0},	     -4,      0,	     0,     0,	0, 0},
+	{{ 0, 0, 0, 1, 0},	     -4,      0,	     0,     0,	0, 0},
+	{{ 1, 0, 2, 0, 0},	      3,      0,	     0,     0,	0, 0},
+	{{-2, 0, 2, 0, 2},	     -3,      0,	     0,     0,	0, 0},
+	{{ 1,-1, 0,-1, 0},	     -3,      0,	     0,     0,	0, 0},
+	{{ 1, 1, 0, 0, 0},	     -3,      0,	     0,     0,	0, 0},
+	{{ 1,-1, 2, 0, 2},	     -3,      0,	     0,     0,	0, 0},
+	{{-1,-1, 2, 2, 2},	     -3,      0,	     0,     0,	0, 0},
+	{{ 3, 0, 2, 0, 2},	     -3,      0,	     0,     0,	0, 0},
+	{{ 0,-1, 2, 2, 2},	     -3,      0,	     0,     0,	0, 0}
+};
+
+/* luni-solar terms of the IAU 2000B model, McCarthy & Luzum 2003, sorted by amplitude */
+/* coefficients are in units of 0.1 microarcseconds */
+static const aaNutationTerm iau2000b_terms[] =
+{
+	{{ 0, 0, 0, 0, 1},	-172064161, -174666,	 92052331,   9086,	 33386,  15377},
+	{{ 0, 0, 2,-2, 2},	 -13170906,   -1675,	  5730336,  -3015,	-13696,  -4587},
+	{{ 0, 0, 2, 0, 2},	  -2276413,    -234,	   978459,   -485,	  2796,   1374},
+	{{ 0, 0, 0, 0, 2},	   2074554,     207,	  -897492,    470,	  -698,   -291},
+	{{ 0, 1, 0, 0, 0},	   1475877,   -3633,	    73871,   -184,	 11817,  -1924},
+	{{ 1, 0, 0, 0, 0},	    711159,      73,	    -6750,      0,	  -872,    358},
+	{{ 0, 1, 2,-2, 2},	   -516821,    1226,	   224386,   -677,	  -524,   -174},
+	{{ 0, 0, 2, 0, 1},	   -387298,    -367,	   200728,     18,	   380,    318},
+	{{ 1, 0, 2, 0, 2},	   -301461,     -36,	   129025,    -63,	   816,    367},
+	{{ 0,-1, 2,-2, 2},	    215829,    -494,	   -95929,    299,	   111,    132},
+	{{-1, 0, 0, 2, 0},	    156994,      10,	    -1235,      0,	  -168,     82},
+	{{ 0, 0, 2,-2, 1},	    128227,     137,	   -68982,     -9,	   181,     39},
+	{{-1, 0, 2, 0, 2},	    123457,      11,	   -53311,     32,	    19,     -4},
+	{{ 0, 0, 0, 2, 0},	     63384,      11,	    -1220,      0,	  -150,     29},
+	{{ 1, 0, 0, 0, 1},	     63110,      63,	   -33228,      0,	    27,     -9},
+	{{-1, 0, 2, 2, 2},	    -59641,     -11,	    25543,    -11,	   149,     66},
+	{{-1, 0, 0, 0, 1},	    -57976,     -63,	    31429,      0,	  -189,    -75},
+	{{ 1, 0, 2, 0, 1},	    -51613,     -42,	    26366,      0,	   129,     78},
+	{{-2, 0, 0, 2, 0},	    -47722,       0,	      477,      0,	   -18,    -25},
+	{{-2, 0, 2, 0, 1},	     45893,      50,	   -24236,    -10,	    31,     20},
+	{{ 0, 0, 2, 2, 2},	    -38571,      -1,	    16452,    -11,	   158,     68},
+	{{ 0,-2, 2,-2, 2},	     32481,       0,	   -13870,      0,	     0,      0},
+	{{ 2, 0, 2, 0, 2},	    -31046,      -1,	    13238,    -11,	   131,     59},
+	{{ 2, 0, 0, 0, 0},	     29243,       0,	     -609,      0,	   -74,     13},
+	{{ 1, 0, 2,-2, 2},	     28593,       0,	   -12338,     10,	    -1,     -3},
+	{{ 0, 0, 2, 0, 0},	     25887,       0,	     -550,      0,	   -66,     11},
+	{{ 0, 0,-2, 2, 0},	     21783,       0,	     -167,      0,	    13,     13},
+	{{-1, 0, 2, 0, 1},	     20441,      21,	   -10758,      0,	    10,     -3},
+	{{ 0, 2, 0, 0, 0},	     16707,     -85,	      168,     -1,	   -10,     10},
+	{{ 0, 2, 2,-2, 2},	    -15794,      72,	     6850,    -42,	   -16,     -5},
+	{{-1, 0, 0, 2, 1},	     15164,      10,	    -8001,      0,	    11,     -1},
+	{{ 0, 1, 0, 0, 1},	    -14053,     -25,	     8551,     -2,	    79,    -45},
+	{{ 1, 0, 0,-2, 1},	    -12873,     -10,	     6953,      0,	   -37,    -14},
+	{{ 0,-1, 0, 0, 1},	    -12654,      11,	     6415,      0,	    63,     26},
+	{{-2, 0, 2, 0, 0},	    -11024,       0,	      104,      0,	   -14,      2},
+	{{-1, 0, 2, 2, 1},	    -10204,       0,	     5222,      0,	    25,     15},
+	{{ 1, 0, 2, 2, 2},	     -7691,       0,	     3268,      0,	    44,     19},
+	{{ 0, 1, 2, 0, 2},	      7566,     -21,	    -3250,      0,	   -11,     -5},
+	{{-1,-1, 0, 2, 0},	      7350,       0,	      -51,      0,	    -8,      4},
+	{{ 0,-1, 2, 0, 2},	     -7141,      21,	     3070,      0,	     8,      4},
+	{{ 0, 0, 2, 2, 1},	     -6637,     -11,	     3353,      0,	    25,     14},
+	{{ 1, 0, 0, 2, 0},	      6579,       0,	     -199,      0,	   -24,      2},
+	{{ 2, 0, 2,-2, 2},	      6443,       0,	    -2768,      0,	    -7,     -4},
+	{{ 0, 0, 0, 2, 1},	     -6302,     -11,	     3272,      0,	     2,      4},
+	{{ 1, 0, 2,-2, 1},	      5800,      10,	    -3045,      0,	     2,     -1},
+	{{-2, 0, 0, 2, 1},	     -5774,     -11,	     3041,      0,	   -15,     -5},
+	{{ 2, 0, 2, 0, 1},	     -5350,       0,	     2695,      0,	    21,     12},
+	{{ 0, 0, 0,-2, 1},	     -4940,     -11,	     2720,      0,	   -21,     -9},
+	{{ 0,-1, 2,-2, 1},	     -4752,     -11,	     2719,      0,	    -3,     -3},
+	{{ 1,-1, 0, 0, 0},	      4725,       0,	      -41,      0,	    -6,      3},
+	{{-1, 0, 0, 1, 0},	      4026,       0,	     -553,      0,	  -353,   -139},
+	{{ 0,-1, 0, 2, 0},	      4348,       0,	      -81,      0,	   -10,      2},
+	{{ 0, 0, 0, 1, 0},	     -4230,       0,	      -20,      0,	     5,     -2},
+	{{ 2, 0, 0,-2, 1},	      4065,       0,	    -2206,      0,	     6,      1},
+	{{-1, 0, 2, 0, 0},	     -4056,       0,	       40,      0,	     5,     -2},
+	{{ 0, 1, 2,-2, 1},	      3579,       0,	    -1900,      0,	     5,      1},
+	{{ 1, 1, 0, 0, 0},	     -3389,       0,	       35,      0,	     5,     -2},
+	{{ 1, 0, 2, 0, 0},	      3339,       0,	     -107,      0,	   -13,      1},
+	{{-1, 1, 0, 1, 0},	      3276,       0,	       -9,      0,	     1,      0},
+	{{-2, 0, 2, 0, 2},	     -3075,       0,	     1313,      0,	    -2,     -1},
+	{{ 3, 0, 2, 0, 2},	     -2904,       0,	     1233,      0,	    15,      7},
+	{{ 1,-1, 2, 0, 2},	     -2878,       0,	     1232,      0,	     8,      4},
+	{{-1,-1, 2, 2, 2},	     -2819,       0,	     1207,      0,	     7,      3},
+	{{ 0,-1, 2, 2, 2},	     -2647,       0,	     1129,      0,	    11,      5},
+	{{ 1, 1, 2, 0, 2},	      2481,       0,	    -1062,      0,	    -7,     -3},
+	{{-2, 0, 0, 0, 1},	     -2294,       0,	     1266,      0,	   -10,     -4},
+	{{ 2, 0, 0, 0, 1},	      2179,       0,	    -1129,      0,	    -2,     -2},
+	{{-1, 0, 2,-2, 1},	     -1987,       0,	     1073,      0,	    -6,     -2},
+	{{ 1, 0, 0, 0, 2},	     -1981,       0,	      854,      0,	     0,      0},
+	{{ 0, 0, 2, 1, 2},	      1660,       0,	     -710,      0,	    -5,     -2},
+	{{-1, 0, 2, 4, 2},	     -1521,       0,	      647,      0,	     9,      4},
+	{{-1, 0, 0, 0, 2},	      1405,       0,	     -610,      0,	     4,      2},
+	{{-2, 0, 2, 2, 2},	      1383,       0,	     -594,      0,	    -2,     -2},
+	{{ 1, 0, 2, 2, 1},	     -1331,       0,	      663,      0,	     8,      4},
+	{{-1, 1, 0, 1, 1},	      1314,       0,	     -700,      0,	     0,      0},
+	{{ 1, 1, 2,-2, 2},	      1290,       0,	     -556,      0,	     0,      0},
+	{{ 0,-2, 2,-2, 1},	     -1283,       0,	      672,      0,	     0,      0}
+};
+
+/* a nutation series and how to evaluate it */
+typedef struct
+{
+	const aaNutationTerm	*term;			/* contiguous table of periodic terms */
+	int						count;			/* number of terms */
+	int						maxmult;		/* largest multiple used by the table */
+	double					scale;			/* table units to arc seconds */
+	double					psiOffset,		/* constant added to deltaPsi in arc seconds */
+							epsOffset;		/* constant added to deltaEpsilon in arc seconds */
+	void					(*arguments)(double T, double arg[5]);
+} NutationSeries;
+
+static void meeus_arguments(double T, double arg[5]);
+static void iau2000b_arguments(double T, double arg[5]);
+static void iers2003_arguments(double T, double arg[5]);
+
+static const NutationSeries meeus_series =
+{
+	meeus_terms, sizeof(meeus_terms) / sizeof(meeus_terms[0]), 3,
+	0.0001, 0, 0, meeus_arguments
+};
+
+/* the planetary terms of IAU 2000B are replaced by a fixed offset */
+static const NutationSeries iau2000b_series =
+{
+	iau2000b_terms, sizeof(iau2000b_terms) / sizeof(iau2000b_terms[0]), 4,
+	1.0e-7, -0.000135, 0.000388, iau2000b_arguments
+};
+
+/* selected model, caller supplied table and a serial bumped on every change */
+static NutationModels	nutation_current = nutation_meeus;
+static NutationSeries	custom_series = { 0, 0, 0, 1.0e-7, 0, 0, iers2003_arguments };
+static unsigned int		nutation_serial = 0;
+
+/* last result of nutation() on this thread, define AA_NO_NUTATION_MEMO to disable */
+#if defined(AA_THREAD_LOCAL) && !defined(AA_NO_NUTATION_MEMO)
+	#define NUT_MEMO
+	
+static AA_THREAD_LOCAL struct
+{
+	int				valid;
+	unsigned int	serial;
+	double			T,
+					tolerance,
+					deltaPsi,
+					deltaEpsilon;
+} nutation_memo;
+#endif
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		meeus_arguments
+		iau2000b_arguments
+		iers2003_arguments
+		
+	PURPOSE:
+		Computes the five fundamental arguments l, l', F, D and omega of a model
+		
+	REFERENCES;
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 132
+		McCarthy, D. D. and Luzum, B. J. "An abridged model of the precession-
+		nutation of the celestial pole." Celestial Mechanics 85. 2003.
+		McCarthy, D. D. and Petit, G. "IERS Conventions (2003)." IERS Technical
+		Note 32. 2004. pp. 48
+			
+	INPUT ARGUMENTS:
+		T (double)
+			Julian Centuries
+	
+	OUTPUT ARGUMENTS:
+	 	arg[] (double)
+	 		l, l', F, D and omega in radians
+	 
+	RETURNED VALUE:
+	 	none
+	 
+	FUNCTIONS CALLED:
+	 	fmod
+	
+----------------------------------------------------------------------------------*/
+static void meeus_arguments(double T, double arg[5])
+{
+	/* mean anomaly of the moon */
+	arg[0] = 134.96298 + 477198.867398 * T + 0.0086972 * T * T + (T * T * T)/56250;
+	
+	/* mean anomaly of the Sun (Earth) */
+	arg[1] = 357.52772 + 35999.050340 * T - 0.0001603 * T * T - (T * T * T)/300000;
+	
+	/* moon's argument of latitude */
+	arg[2] = 93.27191 + 483202.017538 * T - 0.0036825 * T * T + (T * T * T)/327270;
+	
+	/* mean elongation of the moon from the sun */
+	arg[3] = 297.85036 + 445267.111480 * T - 0.0019142 * T * T + (T * T * T)/189474;
+
+	/* longitude of the ascending node of the moon's mean orbit */
+	arg[4] = 125.04452 - 1934.136261 * T + 0.0020708 * T * T + (T * T * T)/450000;
+	
+	arg[0] = fmod(arg[0], 360.0) * kDegRad;
+	arg[1] = fmod(arg[1], 360.0) * kDegRad;
+	arg[2] = fmod(arg[2], 360.0) * kDegRad;
+	arg[3] = fmod(arg[3], 360.0) * kDegRad;
+	arg[4] = fmod(arg[4], 360.0) * kDegRad;
+}
+
+static void iau2000b_arguments(double T, double arg[5])
+{
+	/* linear terms only, in arc seconds */
+	arg[0] = fmod(485868.249036 + 1717915923.2178 * T, 1296000.0) * NUT_ARCSEC;
+	arg[1] = fmod(1287104.79305 + 129596581.0481 * T, 1296000.0) * NUT_ARCSEC;
+	arg[2] = fmod(335779.526232 + 1739527262.8478 * T, 1296000.0) * NUT_ARCSEC;
+	arg[3] = fmod(1072260.70369 + 1602961601.2090 * T, 1296000.0) * NUT_ARCSEC;
+	arg[4] = fmod(450160.398036 - 6962890.5431 * T, 1296000.0) * NUT_ARCSEC;
+}
+
+static void iers2003_arguments(double T, double arg[5])
+{
+	/* full polynomials, in arc seconds */
+	arg[0] = fmod(485868.249036 + T * (1717915923.2178 + T * (31.8792 + T * (0.051635 + T * (-0.00024470)))), 1296000.0) * NUT_ARCSEC;
+	arg[1] = fmod(1287104.793048 + T * (129596581.0481 + T * (-0.5532 + T * (0.000136 + T * (-0.00001149)))), 1296000.0) * NUT_ARCSEC;
+	arg[2] = fmod(335779.526232 + T * (1739527262.8478 + T * (-12.7512 + T * (-0.001037 + T * (0.00000417)))), 1296000.0) * NUT_ARCSEC;
+	arg[3] = fmod(1072260.703692 + T * (1602961601.2090 + T * (-6.3706 + T * (0.006593 + T * (-0.00003169)))), 1296000.0) * NUT_ARCSEC;
+	arg[4] = fmod(450160.398036 + T * (-6962890.5431 + T * (7.4722 + T * (0.007702 + T * (-0.00005939)))), 1296000.0) * NUT_ARCSEC;
+}
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		nutation_series
+		
+	PURPOSE:
+		Sums the periodic terms of a nutation table in one pass
+		
+	REFERENCES;
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 132
+			
+	INPUT ARGUMENTS:
+		series (const NutationSeries*)
+			table of periodic terms and its fundamental arguments
+		T (double)
+			Julian Centuries
+		tolerance (double)
+			largest error allowed from dropping terms in arc seconds, 0 for all terms
+	
+	OUTPUT ARGUMENTS:
+	 	*deltaPsi (double)
+	 		nutation of longitude in arc seconds
+	 	*deltaEpsilon (double)
+	 		nutation of obliquity in arc seconds
+	 
+	RETURNED VALUE:
+	 	none
+	 
+	GLOBALS USED:
+	 	none
+	 
+	FUNCTIONS CALLED:
+	 	sin, cos, fabs
+	 
+	NOTES:
+		The sine and cosine of each fundamental argument are evaluated once, the
+		multiples are built with the angle addition formulas and every term is
+		then the product of five unit complex numbers, so no trigonometric call
+		is made per term.  The cost is ten trig calls plus about 30 flops a term.
+		Tables are sorted by amplitude, so a tolerance drops terms from the end
+		for as long as the sum of the dropped amplitudes stays within it.
+	
+----------------------------------------------------------------------------------*/
+static void nutation_series(const NutationSeries *series, double T, double tolerance,
+							double *deltaPsi, double *deltaEpsilon)
+{
+	const aaNutationTerm	*term = series->term;
+	int		count = series->count;
+	double	arg[5];						/* fundamental arguments in radians */
+	double	c[5][2 * NUT_MAXMULT + 1],	/* cos(k * arg), k = -NUT_MAXMULT..NUT_MAXMULT */
+			s[5][2 * NUT_MAXMULT + 1];	/* sin(k * arg) */
+	double	psi = 0,
+			eps = 0;
+	int		i, j, k;
+	
+	/* drop the smallest terms that fit in the tolerance */
+	if ( tolerance > 0 )
+	{
+		double	budget = tolerance / series->scale,
+				psiAmp,
+				epsAmp;
+		
+		for ( ; count > 0; --count, budget -= psiAmp )
+		{
+			psiAmp = fabs(term[count - 1].ps) + fabs(term[count - 1].pst * T) + fabs(term[count - 1].pc);
+			epsAmp = fabs(term[count - 1].ec) + fabs(term[count - 1].ect * T) + fabs(term[count - 1].es);
+			
+			if ( epsAmp > psiAmp )
+				psiAmp = epsAmp;
+			if ( psiAmp > budget )
+				break;
+		}
+	}
+	
+	series->arguments(T, arg);
+	
+	/* build the multiples of each fundamental argument */
+	for ( j = 0; j < 5; ++j )
+	{
+		c[j][NUT_MAXMULT] = 1;
+		s[j][NUT_MAXMULT] = 0;
+		c[j][NUT_MAXMULT + 1] = cos(arg[j]);
+		s[j][NUT_MAXMULT + 1] = sin(arg[j]);
+		
+		for ( k = 2; k <= series->maxmult; ++k )
+		{
+			c[j][NUT_MAXMULT + k] = c[j][NUT_MAXMULT + k - 1] * c[j][NUT_MAXMULT + 1]
+								  - s[j][NUT_MAXMULT + k - 1] * s[j][NUT_MAXMULT + 1];
+			s[j][NUT_MAXMULT + k] = s[j][NUT_MAXMULT + k - 1] * c[j][NUT_MAXMULT + 1]
+								  + c[j][NUT_MAXMULT + k - 1] * s[j][NUT_MAXMULT + 1];
+		}
+		
+		for ( k = 1; k <= series->maxmult; ++k )
+		{
+			c[j][NUT_MAXMULT - k] = c[j][NUT_MAXMULT + k];
+			s[j][NUT_MAXMULT - k] = -s[j][NUT_MAXMULT + k];
+		}
+	}
+	
+	/* sum both series */
+	for ( i = 0; i < count; ++i, ++term )
+	{
+		double	ca = c[0][NUT_MAXMULT + term->arg[0]],
+				sa = s[0][NUT_MAXMULT + term->arg[0]],
+				t;
+		
+		for ( j = 1; j < 5; ++j )
+		{
+			t  = ca * c[j][NUT_MAXMULT + term->arg[j]] - sa * s[j][NUT_MAXMULT + term->arg[j]];
+			sa = sa * c[j][NUT_MAXMULT + term->arg[j]] + ca * s[j][NUT_MAXMULT + term->arg[j]];
+			ca = t;
+		}
+		
+		psi += (term->ps + term->pst * T) * sa + term->pc * ca;
+		eps += (term->ec + term->ect * T) * ca + term->es * sa;
+	}
+	
+	*deltaPsi = psi * series->scale + series->psiOffset;
+	*deltaEpsilon = eps * series->scale + series->epsOffset;
+}
 
 
 /* ---------------------------------------------------------------------------------
@@ -30,7 +441,7 @@
 	 	none
 	 
 	FUNCTIONS CALLED:
-	 	none
+	 	nutation_tol, aa_get_tolerance
 	 
 	DATE/PROGRAMMER/NOTE:
 		07-06-2000	Todd A. Guillory	created
@@ -38,133 +449,197 @@
 		07-25-2000	Todd A. Guillory	tested with example 21.a
 	 	
 	NOTES:
+		Evaluates the series selected with nutation_set_model(), by default the
+		63 correction factors of table 21.A, truncated to the angle tolerance set
+		with aa_set_tolerance().
 	
 ----------------------------------------------------------------------------------*/
 void nutation( double T, double *deltaPsi, double *deltaEpsilon)
 {
-	double	D, 		/* longitude of the ascending node of the moon's mean orbit */
-			m,		/* mean anomaly of the Sun (Earth) */
-			mprime,	/* mean anomaly of the moon */
-			F,		/* moon's argument of latitude */
-			omega;	/* longitude of the ascending node of the moon's mean orbit */
-	
-	/* calculate the five local variables */
-	D = 297.85036 + 445267.111480 * T - 0.0019142 * T * T + (T * T * T)/189474;
-
-	m = 357.52772 + 35999.050340 * T - 0.0001603 * T * T - (T * T * T)/300000;
-	
-	mprime = 134.96298 + 477198.867398 * T + 0.0086972 * T * T + (T * T * T)/56250;
-	
-	F = 93.27191 + 483202.017538 * T - 0.0036825 * T * T + (T * T * T)/327270;
-
-	omega = 125.04452 - 1934.136261 * T + 0.0020708 * T * T + (T * T * T)/450000;
-	
-	/* calculate nutation of longitude in arc seconds */
-	*deltaPsi =		(-171996	- 174.2*T)	* SinD(omega)
-				+	(-13187		- 1.6*T)	* SinD(-2*D + 2*F + 2*omega)
-				+	(-2274		- 0.2*T)	* SinD(2*F + 2*omega)
-				+	(2062		+ 0.2*T)	* SinD(2*omega)
-				+	(1426		- 3.4*T)	* SinD(m)
-				+	(712		+ 0.1*T)	* SinD(mprime)
-				+	(-517		+ 1.2*T)	* SinD(-2*D + m + 2*F + 2*omega)
-				+	(-386		- 0.4*T)	* SinD(2*F + omega)
-				-	301						* SinD(mprime + 2*F + 2*omega)
-				+	(217		- 0.5*T)	* SinD(-2*D - m + 2*F + 2*omega)
-				-	158						* SinD(-2*D + mprime)
-				+	(129		+ 0.1*T)	* SinD(-2*D + 2*F + omega)
-				+	123						* SinD(-mprime + 2*F + 2*omega)
-				+	63						* SinD(2*D)
-				+	(63			+ 0.1*T)	* SinD(mprime + omega)
-				-	59						* SinD(2*D - mprime + 2*F + 2*omega)
-				+	(-58		- 0.1*T)	* SinD(-mprime + omega)
-				-	51						* SinD(mprime + 2*F + omega)
-				+	48						* SinD(-2*D + 2*mprime)
-				+	46						* SinD(-2*mprime + 2*F + omega)
-				-	38						* SinD(2*D + 2*F + 2*omega)
-				-	31						* SinD(2*mprime + 2*F + 2*omega)
-				+	29						* SinD(2*mprime)
-				+	29						* SinD(-2*D + mprime + 2*F + 2*omega)
-				+	26						* SinD(2*F)
-				-	22						* SinD(-2*D + 2*F)
-				+	21						* SinD(-mprime + 2*F + omega)
-				+	(17			- 0.1*T)	* SinD(2*m)
-				+	16						* SinD(2*D - mprime + omega)
-				+	(-16		+ 0.1*T)	* SinD(-2*D + 2*m + 2*F + 2*omega)
-				-	15						* SinD(m + omega)
-				-	13						* SinD(-2*D + mprime + omega)
-				-	12						* SinD(-m + omega)
-				+	11						* SinD(2*mprime - 2*F)
-				-	10						* SinD(2*D - mprime + 2*F + omega)
-				-	8						* SinD(2*D + mprime + 2*F + 2*omega)
-				+	7						* SinD(m + 2*F + 2*omega)
-				-	7						* SinD(-2*D + m + mprime)
-				-	7						* SinD(-m + 2*F + 2*omega)
-				-	7						* SinD(2*D + 2*F + omega)
-				+	6						* SinD(2*D + mprime)
-				+	6						* SinD(-2*D + 2*mprime + 2*F + 2*omega)
-				+	6						* SinD(-2*D + mprime + 2*F + omega)
-				-	6						* SinD(2*D - 2*mprime + omega)
-				-	6						* SinD(2*D + omega)
-				+	5						* SinD(-m + mprime)
-				-	5						* SinD(-2*D - m + 2*F + omega)
-				-	5						* SinD(-2*D + omega)
-				-	5						* SinD(2*mprime + 2*F + omega)
-				+	4						* SinD(-2*D + 2*mprime + omega)
-				+	4						* SinD(-2*D + m + 2*F + omega)
-				+	4						* SinD(mprime - 2*F)
-				-	4						* SinD(-D + mprime)
-				-	4						* SinD(-2*D + m)
-				-	4						* SinD(D)
-				+	3						* SinD(mprime + 2*F)
-				-	3						* SinD(-2*mprime + 2*F + 2*omega)
-				-	3						* SinD(-D - m + mprime)
-				-	3						* SinD(m + mprime)
-				-	3						* SinD(-m + mprime + 2*F + 2*omega)
-				-	3						* SinD(2*D - m -mprime + 2*F + 2*omega)
-				-	3						* SinD(3*mprime + 2*F + 2*omega)
-				-	3						* SinD(2*D - m + 2*F + 2*omega);
-	
-	/* calculate nutation of obliquity in arc seconds */
-	*deltaEpsilon =	(92025		+ 8.9*T)	* CosD(omega)
-				+	(5736		- 3.1*T)	* CosD(-2*D + 2*F + 2*omega)
-				+	(977		- 0.5*T)	* CosD(2*F + 2*omega)
-				+	(-895		+ 0.5*T)	* CosD(2*omega)
-				+	(54			- 0.1*T)	* CosD(m)
-				-	7						* CosD(mprime)
-				+	(224		- 0.6*T)	* CosD(-2*D + m + 2*F + 2*omega)
-				+	200						* CosD(2*F + omega)
-				+	(129		- 0.1*T)	* CosD(mprime + 2*F + 2*omega)
-				+	(-95		+ 0.3*T)	* CosD(-2*D - m + 2*F + 2*omega)
-				-	70						* CosD(-2*D + 2*F + omega)
-				-	53						* CosD(-mprime + 2*F + 2*omega)
-				-	33						* CosD(mprime + omega)
-				+	26						* CosD(2*D - mprime + 2*F + 2*omega)
-				+	32						* CosD(-mprime + omega)
-				+	27						* CosD(mprime + 2*F + omega)
-				-	24						* CosD(-2*mprime + 2*F + omega)
-				+	16						* CosD(2*D + 2*F + 2*omega)
-				+	13						* CosD(2*mprime + 2*F + 2*omega)
-				-	12						* CosD(-2*D + mprime + 2*F + 2*omega)
-				-	10						* CosD(-mprime + 2*F + omega)
-				-	8						* CosD(2*D - mprime + omega)
-				+	7						* CosD(-2*D + 2*m + 2*F + 2*omega)
-				+	9						* CosD(m + omega)
-				+	7						* CosD(-2*D + mprime + omega)
-				+	6						* CosD(-m + omega)
-				+	5						* CosD(2*D - mprime + 2*F + omega)
-				+	3						* CosD(2*D + mprime + 2*F + 2*omega)
-				-	3						* CosD(m + 2*F + 2*omega)
-				+	3						* CosD(-m + 2*F + 2*omega)
-				+	3						* CosD(2*D + 2*F + omega)
-				-	3						* CosD(-2*D + 2*mprime + 2*F + 2*omega)
-				-	3						* CosD(-2*D + mprime + 2*F + omega)
-				+	3						* CosD(2*D - 2*mprime + omega)
-				+	3						* CosD(2*D + omega)
-				+	3						* CosD(-2*D - m + 2*F + omega)
-				+	3						* CosD(-2*D + omega)
-				+	3						* CosD(2*mprime + 2*F + omega);	
-	
-	/* coefficients are in units of 0".0001 so convert */
-	*deltaPsi *= 0.0001;			
-	*deltaEpsilon *= 0.0001;
-}
\ No newline at end of file
+	double	arcseconds,		/* angle tolerance */
+			seconds;		/* time tolerance */
+	
+	aa_get_tolerance(&arcseconds, &seconds);
+	
+	nutation_tol(T, arcseconds, deltaPsi, deltaEpsilon);
+}
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		nutation_tol
+		
+	PURPOSE:
+		Computes the nutation of longitude and obliquity using only the largest
+		periodic terms needed to meet a tolerance
+		
+	INPUT ARGUMENTS:
+		T (double)
+			Julian Centuries
+		tolerance (double)
+			largest error allowed from dropped terms in arc seconds, 0 for all terms
+	
+	OUTPUT ARGUMENTS:
+	 	*deltaPsi (double)
+	 		nutation of longitude in arc seconds
+	 	*deltaEpsilon (double)
+	 		nutation of obliquity in arc seconds
+	 
+	RETURNED VALUE:
+	 	none
+	 
+	GLOBALS USED:
+	 	nutation_current, nutation_memo
+	 
+	FUNCTIONS CALLED:
+	 	nutation_series
+	 	
+	NOTES:
+		The tolerance bounds the truncation error only, the model itself is
+		good to about 0".5 (nutation_meeus) or 0".001 (nutation_iau2000b).
+		The last result is memoized per thread, so repeated calls for the same
+		instant (sidereal time, obliquity, many targets at one JD) are free.
+	
+----------------------------------------------------------------------------------*/
+void nutation_tol( double T, double tolerance, double *deltaPsi, double *deltaEpsilon)
+{
+	const NutationSeries	*series;
+	
+#ifdef NUT_MEMO
+	if ( nutation_memo.valid && nutation_memo.T == T && nutation_memo.serial == nutation_serial
+		&& nutation_memo.tolerance == tolerance )
+	{
+		*deltaPsi = nutation_memo.deltaPsi;
+		*deltaEpsilon = nutation_memo.deltaEpsilon;
+		return;
+	}
+#endif
+	
+	if ( nutation_current == nutation_iau2000b )
+		series = &iau2000b_series;
+	else if ( nutation_current == nutation_custom )
+		series = &custom_series;
+	else
+		series = &meeus_series;
+	
+	nutation_series(series, T, tolerance, deltaPsi, deltaEpsilon);
+	
+#ifdef NUT_MEMO
+	nutation_memo.T = T;
+	nutation_memo.serial = nutation_serial;
+	nutation_memo.tolerance = tolerance;
+	nutation_memo.deltaPsi = *deltaPsi;
+	nutation_memo.deltaEpsilon = *deltaEpsilon;
+	nutation_memo.valid = 1;
+#endif
+}
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		nutation_set_model
+		nutation_get_model
+		
+	PURPOSE:
+		Selects the nutation series used by nutation(), obliquity(),
+		app_sidereal_time() and azimuth_altitude()
+		
+	INPUT ARGUMENTS:
+		model (NutationModels)
+			nutation_meeus, nutation_iau2000b or nutation_custom
+	
+	OUTPUT ARGUMENTS:
+	 	none
+	 
+	RETURNED VALUE:
+	 	1 if the model was selected
+	 	0 if the model is unknown or nutation_custom has no table yet
+	 
+	GLOBALS USED:
+	 	nutation_current, nutation_serial
+	 
+	NOTES:
+		The model is process wide, select it once at start up before any
+		thread calls into the library.
+	
+----------------------------------------------------------------------------------*/
+int nutation_set_model( NutationModels model )
+{
+	if ( model != nutation_meeus && model != nutation_iau2000b && model != nutation_custom )
+		return 0;
+	
+	if ( model == nutation_custom && custom_series.count == 0 )
+		return 0;
+	
+	nutation_current = model;
+	++nutation_serial;
+	
+	return 1;
+}
+
+NutationModels nutation_get_model( void )
+{
+	return nutation_current;
+}
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		nutation_set_table
+		
+	PURPOSE:
+		Installs a caller supplied table of periodic terms for nutation_custom
+		
+	REFERENCES;
+		McCarthy, D. D. and Petit, G. "IERS Conventions (2003)." IERS Technical
+		Note 32. 2004. pp. 48
+			
+	INPUT ARGUMENTS:
+		terms (const aaNutationTerm*)
+			contiguous table of periodic terms, coefficients in 0.1 microarcseconds
+		count (int)
+			number of terms in the table
+	
+	OUTPUT ARGUMENTS:
+	 	none
+	 
+	RETURNED VALUE:
+	 	1 if the table was installed
+	 	0 if the table is empty or a multiple is larger than 8
+	 
+	GLOBALS USED:
+	 	custom_series, nutation_serial
+	 
+	NOTES:
+		The table is not copied, it must stay valid while nutation_custom is
+		selected.  Arguments use the full IERS 2003 fundamental argument
+		polynomials, so the luni-solar part of IAU 2000A can be loaded as is.
+		Evaluation cost is linear in count with no trig call per term.  Sort
+		the table by decreasing amplitude so tolerances can truncate it.
+	
+----------------------------------------------------------------------------------*/
+int nutation_set_table( const aaNutationTerm *terms, int count )
+{
+	int		i, j, maxmult = 1;
+	
+	if ( terms == 0 || count <= 0 )
+		return 0;
+	
+	for ( i = 0; i < count; ++i )
+		for ( j = 0; j < 5; ++j )
+		{
+			if ( terms[i].arg[j] > NUT_MAXMULT || terms[i].arg[j] < -NUT_MAXMULT )
+				return 0;
+			if ( terms[i].arg[j] > maxmult )
+				maxmult = terms[i].arg[j];
+			else if ( -terms[i].arg[j] > maxmult )
+				maxmult = -terms[i].arg[j];
+		}
+	
+	custom_series.term = terms;
+	custom_series.count = count;
+	custom_series.maxmult = maxmult;
+	++nutation_serial;
+	
+	return 1;
+}
@@ -1,4 +1,5 @@
 #include "astroalgo.h"
+#include "astrointernal.h"
 
 /* ---------------------------------------------------------------------------------
 	NAME:
@@ -19,7 +20,7 @@
 	 	*epsilon (double)
 	 		true obliquity of the ecliptic in degrees
 	 	*epsilonNull (double)
-	 		mean obliquity of the ecliptic in arc seconds
+	 		mean obliquity of the ecliptic in degrees
 	 
 	RETURNED VALUE:
 	 	none yet
@@ -28,7 +29,7 @@
 	 	none
 	 
 	FUNCTIONS CALLED:
-	 	Nutation
+	 	nutation_obliquity
 	 
 	DATE/PROGRAMMER/NOTE:
 		07-06-2000	Todd A. Guillory	created
@@ -42,13 +43,60 @@ void obliquity( double T, double *epsilon, double *epsilonNull)
 	double	deltaPsi,		/* nutation of longitude in arc seconds */
 			deltaEpsilon;	/* nutation of obliquity */
 	
+	nutation_obliquity(T, &deltaPsi, &deltaEpsilon, epsilon, epsilonNull);
+}
+
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		nutation_obliquity
+		
+	PURPOSE:
+		Computes the nutation and the mean and true obliquity of the ecliptic
+		with a single evaluation of the nutation series
+		
+	REFERENCES;
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 131-136
+			
+	INPUT ARGUMENTS:
+		T (double)
+			Julian Centuries
+	
+	OUTPUT ARGUMENTS:
+	 	*deltaPsi (double)
+	 		nutation of longitude in arc seconds
+	 	*deltaEpsilon (double)
+	 		nutation of obliquity in arc seconds
+	 	*epsilon (double)
+	 		true obliquity of the ecliptic in degrees
+	 	*epsilonNull (double)
+	 		mean obliquity of the ecliptic in degrees
+	 
+	RETURNED VALUE:
+	 	none
+	 
+	GLOBALS USED:
+	 	none
+	 
+	FUNCTIONS CALLED:
+	 	nutation
+	 	
+	NOTES:
+		Internal, declared in astrointernal.h.  Callers that need both the
+		nutation and the obliquity should use this instead of nutation()
+		followed by obliquity().
+	
+----------------------------------------------------------------------------------*/
+void nutation_obliquity( double T, double *deltaPsi, double *deltaEpsilon, double *epsilon, double *epsilonNull)
+{
 	/* calculate mean obliquity of the ecliptic */
 	*epsilonNull = ((23 * 60) + 26) * 60 + 21.448 - 46.8150 * T - 0.00059 * T * T + 0.001813 * T * T * T;
 	*epsilonNull /= 3600;
 	
-	/* calculate nutation of obliquity */
-	nutation(T, &deltaPsi, &deltaEpsilon);
+	/* calculate nutation of longitude and obliquity */
+	nutation(T, deltaPsi, deltaEpsilon);
 	
 	/* calculate true obliquity of the ecliptic */
-	*epsilon = *epsilonNull + deltaEpsilon / 3600;
-}
\ No newline at end of file
+	*epsilon = *epsilonNull + *deltaEpsilon / 3600;
+}
@@ -0,0 +1,64 @@
+#include "astroalgo.h"
+#include "astromath.h"
+
+/* C Headers */
+#include <math.h>
+
+/*******************************************************************************
+	NAME:
+		observer_init
+
+	PURPOSE:
+		Describes a site once for the _obs functions, with its latitude and
+		horizon trig computed here instead of on every call
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 98 for h0
+		Explanatory Supplement to the Astronomical Almanac. University Science
+			Books. 1992. pp. 484 for the dip
+
+	INPUT ARGUMENTS:
+		L (double)
+			longitude in degrees, positive west
+		phi (double)
+			latitude in degrees
+		elevation (double)
+			height in meters above the horizon the observer sees, 0 for a
+			horizon at eye level
+		h0 (double)
+			standard altitude at rising and setting in degrees, see
+			rise_tran_set
+
+	OUTPUT ARGUMENTS:
+		*observer (aaObserver)
+			the site
+
+	RETURNED VALUE:
+		none
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		SinCosD, SinD, sqrt
+
+	NOTES:
+		An elevated observer sees the horizon dip below the astronomical
+		horizon by about 1'.76 sqrt(meters), refraction included, and sees
+		bodies rise that much earlier and set later.  The dip lowers h0 into
+		observer->horizon, used by rise_tran_set_obs.  Fill the fields by
+		hand to use a different horizon.
+
+********************************************************************************/
+void observer_init(aaObserver *observer, double L, double phi, double elevation, double h0)
+{
+	observer->L = L;
+	observer->phi = phi;
+	observer->elevation = elevation;
+	observer->h0 = h0;
+	observer->horizon = h0 - ( ( elevation > 0 ) ? 0.02933 * sqrt(elevation) : 0 );
+
+	SinCosD(phi, &observer->sinPhi, &observer->cosPhi);
+	observer->sinHorizon = SinD(observer->horizon);
+}
@@ -0,0 +1,260 @@
+#include "astroalgo.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <stdlib.h>
+
+#if !defined(AA_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+	#include <unistd.h>
+#endif
+
+/* the batch functions run on POSIX threads where the system has them */
+#if !defined(AA_NO_THREADS) && defined(_POSIX_THREADS) && _POSIX_THREADS > 0
+	#include <pthread.h>
+	#define AA_PTHREADS			1
+#else
+	#define AA_PTHREADS			0
+#endif
+
+/* most threads a batch call runs on */
+#define AA_MAX_THREADS			64
+
+/* threads used by the batch functions, 0 until first use */
+static int		aa_threads = 0;
+
+/*******************************************************************************
+	NAME:
+		aa_threads_detect
+
+	PURPOSE:
+		Picks the number of threads for the batch functions, the processors
+		online or the ASTROALGO_THREADS environment variable when it is set
+
+	REFERENCES:
+		none
+
+	INPUT ARGUMENTS:
+		none
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		number of threads, 1 to AA_MAX_THREADS
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		getenv, atoi, sysconf
+
+	NOTES:
+		Always 1 for a build without POSIX threads.
+
+********************************************************************************/
+static int aa_threads_detect(void)
+{
+#if AA_PTHREADS
+	const char	*env = getenv("ASTROALGO_THREADS");
+	long		count = ( env != NULL ) ? atoi(env) : 0;
+
+	#if defined(_SC_NPROCESSORS_ONLN)
+	if ( count <= 0 )
+		count = sysconf(_SC_NPROCESSORS_ONLN);
+	#endif
+
+	if ( count < 1 )
+		return 1;
+
+	return ( count > AA_MAX_THREADS ) ? AA_MAX_THREADS : (int) count;
+#else
+	return 1;
+#endif
+}
+
+/*******************************************************************************
+	NAME:
+		aa_get_threads
+		aa_set_threads
+
+	PURPOSE:
+		Returns or overrides the number of threads the batch functions
+		spread their work over
+
+	REFERENCES:
+		none
+
+	INPUT ARGUMENTS:
+		count (int)
+			number of threads, 1 to run on the calling thread alone, 0 or
+			less to go back to the detected number
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		aa_get_threads: current number of threads
+		aa_set_threads: 1 if the number was selected, 0 if it was limited
+		to what the build supports
+
+	GLOBALS USED:
+		aa_threads
+
+	FUNCTIONS CALLED:
+		aa_threads_detect
+
+	NOTES:
+		solar_geometry_grid, rise_tran_set_raster and the solar altitude
+		rasters use these threads.  They are POSIX threads, link with
+		-pthread, a build without them, or with AA_NO_THREADS defined, runs
+		on the calling thread.  Set the count before starting threads of
+		your own, as for aa_set_isa.
+
+********************************************************************************/
+int aa_get_threads(void)
+{
+	if ( aa_threads <= 0 )
+		aa_threads = aa_threads_detect();
+
+	return aa_threads;
+}
+
+int aa_set_threads(int count)
+{
+	if ( count <= 0 )
+	{
+		aa_threads = aa_threads_detect();
+		return 1;
+	}
+
+#if AA_PTHREADS
+	aa_threads = ( count > AA_MAX_THREADS ) ? AA_MAX_THREADS : count;
+	return count <= AA_MAX_THREADS;
+#else
+	aa_threads = 1;
+	return count == 1;
+#endif
+}
+
+#if AA_PTHREADS
+/* work shared by the threads of one aa_parallel_for call */
+typedef struct
+{
+	void			(*body)(void *context, int begin, int end);
+	void			*context;
+	int				n, grain, next;
+	pthread_mutex_t	lock;
+} AaParallelFor;
+
+/* takes the next chunk of the range, 0 when it is all taken */
+static int aa_parallel_next(AaParallelFor *work, int *begin, int *end)
+{
+	pthread_mutex_lock(&work->lock);
+	*begin = work->next;
+	work->next = ( work->n - *begin < work->grain ) ? work->n : *begin + work->grain;
+	*end = work->next;
+	pthread_mutex_unlock(&work->lock);
+
+	return *begin < *end;
+}
+
+static void *aa_parallel_worker(void *arg)
+{
+	AaParallelFor	*work = (AaParallelFor *) arg;
+	int				begin, end;
+
+	while ( aa_parallel_next(work, &begin, &end) )
+		work->body(work->context, begin, end);
+
+	return NULL;
+}
+#endif
+
+/*******************************************************************************
+	NAME:
+		aa_parallel_for
+
+	PURPOSE:
+		Runs body over the range [0, n) in chunks spread over the threads of
+		aa_get_threads
+
+	REFERENCES:
+		none
+
+	INPUT ARGUMENTS:
+		n (int)
+			size of the range
+		grain (int)
+			size of a chunk, the last one may be shorter
+		body (function)
+			called with context and the bounds of each chunk
+		*context (void)
+			passed to body
+
+	OUTPUT ARGUMENTS:
+		none
+
+	RETURNED VALUE:
+		none
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		aa_get_threads, pthread_create, pthread_join, pthread_mutex_lock,
+		pthread_mutex_unlock
+
+	NOTES:
+		The calling thread takes chunks too, and a thread takes the next
+		free chunk when it is done with one, so rows of uneven cost balance.
+		No more threads are started than there are chunks, and with one
+		chunk or one thread body runs once over the whole range on the
+		calling thread.  When a thread cannot be started the others do its
+		share, so every chunk is always run, once, and chunks must not
+		write to the same memory.
+
+********************************************************************************/
+void aa_parallel_for(int n, int grain, void (*body)(void *context, int begin, int end), void *context)
+{
+#if AA_PTHREADS
+	pthread_t		threads[AA_MAX_THREADS];
+	AaParallelFor	work;
+	int				chunks, count, started;
+#endif
+
+	if ( n <= 0 )
+		return;
+
+	if ( grain < 1 )
+		grain = 1;
+
+#if AA_PTHREADS
+	chunks = n / grain + ( n % grain != 0 );
+	count = aa_get_threads();
+	if ( count > chunks )
+		count = chunks;
+
+	if ( count > 1 && pthread_mutex_init(&work.lock, NULL) == 0 )
+	{
+		work.body = body;
+		work.context = context;
+		work.n = n;
+		work.grain = grain;
+		work.next = 0;
+
+		for ( started = 0; started < count - 1; ++started )
+			if ( pthread_create(&threads[started], NULL, aa_parallel_worker, &work) != 0 )
+				break;
+
+		aa_parallel_worker(&work);
+
+		while ( started > 0 )
+			pthread_join(threads[--started], NULL);
+
+		pthread_mutex_destroy(&work.lock);
+		return;
+	}
+#endif
+
+	body(context, 0, n);
+}
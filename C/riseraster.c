@@ -0,0 +1,234 @@
+#include "astroalgo.h"
+#include "astromath.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+#ifdef NAN
+	#define RASTER_NAN		NAN
+#else
+	#define RASTER_NAN		(HUGE_VAL - HUGE_VAL)
+#endif
+
+/* a row is done in blocks of this many cells */
+#define RASTER_BLOCK		256
+
+/* what every cell of a day shares */
+typedef struct
+{
+	double		A[3], D[3];			/* the sun at 0h TD, A[0] and A[2] on the turn of A[1] */
+	double		theta0;				/* apparent sidereal time at 0h UT */
+	double		deltaT;				/* TD - UT in seconds as rise_tran_set uses it */
+	double		h0, sinH0;			/* standard altitude */
+} RiseSetDay;
+
+/* kernel loops for each instruction set, see riseraster_kernels.h */
+#define BATCH_KERNELS	"riseraster_kernels.h"
+#include "batchisa.h"
+
+/* reference loop over rise_tran_set_site */
+static void rise_set_row_scalar(const RiseSetDay *day, const double *m0, const double *L,
+	double H0, double sinPhi, double cosPhi, float *rise, float *set, int n)
+{
+	double	m[3];
+	int		i;
+
+	(void) m0;
+	(void) H0;
+
+	for ( i = 0; i < n; ++i )
+	{
+		rise_tran_set_site(L[i], sinPhi, cosPhi, day->h0, day->sinH0, day->theta0, day->deltaT, day->A, day->D, m);
+		rise[i] = (float) m[1];
+		set[i] = (float) m[2];
+	}
+}
+
+/* dispatch table indexed by IsaLevels */
+static void (* const raster_row[])(const RiseSetDay *day, const double *m0, const double *L,
+	double H0, double sinPhi, double cosPhi, float *rise, float *set, int n) =
+	BATCH_FUNCTIONS(rise_set_row);
+
+/* the day, the columns and the outputs of a raster */
+typedef struct
+{
+	void				(*kernel)(const RiseSetDay *, const double *, const double *, double, double, double,
+							float *, float *, int);
+	const RiseSetDay	*day;
+	const double		*L, *m0;
+	double				sinDelta, cosDelta, phi0, dphi;
+	int					cols;
+	float				*rise, *set;
+	signed char			*state;
+} RiseSetRaster;
+
+/* the rows begin to end, one chunk of aa_parallel_for */
+static void rise_set_rows(void *context, int begin, int end)
+{
+	const RiseSetRaster	*raster = (const RiseSetRaster *) context;
+	double				sinPhi, cosPhi, cosH0, H0;
+	size_t				row;
+	int					r, s, i, len, cols = raster->cols;
+
+	for ( r = begin; r < end; ++r )
+	{
+		row = (size_t) r * (size_t) cols;
+
+		SinCosD(raster->phi0 + r * raster->dphi, &sinPhi, &cosPhi);
+
+		/* the test of rise_tran_set_site */
+		cosH0 = (raster->day->sinH0 - sinPhi * raster->sinDelta) / (cosPhi * raster->cosDelta);
+		s = ( cosH0 > 1 ) ? rs_always_below : ( cosH0 < -1 ) ? rs_always_above : rs_rises_sets;
+
+		raster->state[r] = (signed char) s;
+
+		if ( s != rs_rises_sets )
+		{
+			for ( i = 0; i < cols; ++i )
+				raster->rise[row + i] = raster->set[row + i] = (float) RASTER_NAN;
+			continue;
+		}
+
+		H0 = acos(cosH0) * kRadDeg;
+
+		for ( i = 0; i < cols; i += RASTER_BLOCK )
+		{
+			len = ( cols - i < RASTER_BLOCK ) ? cols - i : RASTER_BLOCK;
+			raster->kernel(raster->day, raster->m0 + i, raster->L + i, H0, sinPhi, cosPhi,
+				raster->rise + row + i, raster->set + row + i, len);
+		}
+	}
+}
+
+/*******************************************************************************
+	NAME:
+		rise_tran_set_raster
+
+	PURPOSE:
+		Computes sunrise, sunset and transit over a latitude and longitude
+		grid for one day, with masks of polar day and polar night
+
+	REFERENCES:
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 97-99
+
+	INPUT ARGUMENTS:
+		JD (double)
+			Julian Day at 0 hour UT of the day
+		h0 (double)
+			standard altitude, -0.8333 for the sun
+		phi0, dphi (double)
+			latitude of the first row and the step between rows in degrees
+		rows (int)
+			number of rows
+		L0, dL (double)
+			longitude of the first column and the step between columns in
+			degrees, positive west
+		cols (int)
+			number of columns
+
+	OUTPUT ARGUMENTS:
+		rise[], set[] (float)
+			rising and setting as fractions of the day UT, rows * cols, row
+			major, NaN in the rows without them
+		transit[] (double)
+			transit as a fraction of the day UT, cols, or NULL
+		state[] (signed char)
+			RiseSetStates of every row, rs_always_above for polar day and
+			rs_always_below for polar night, rows, or NULL
+
+	RETURNED VALUE:
+		number of rows where the sun rises and sets
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		solar_coordinates_T, app_sidereal_time, delta_t, aa_get_isa,
+		rise_tran_set_site, SinCosD, Normalize0To1, revolution_180,
+		aa_parallel_for
+
+	NOTES:
+		Every cell gives what rise_tran_set gives with the sun at 0 hour TD
+		of JD - 1, JD and JD + 1 from app_solar_coordinates, within the
+		rounding to float.
+
+		The sun, the sidereal time and DeltaT are computed once for the
+		day.  rise_tran_set decides polar day and night from the declination
+		on JD alone, so the state is one per row, and the transit does not
+		depend on the latitude, so it is one per column.  A row then runs
+		over its cells in a loop that vectorizes but for asin.  The rows are
+		spread over the threads of aa_set_threads().
+
+********************************************************************************/
+int rise_tran_set_raster(double JD, double h0, double phi0, double dphi, int rows,
+	double L0, double dL, int cols, float rise[], float set[], double transit[], signed char state[])
+{
+	RiseSetRaster	raster;
+	RiseSetDay		day;
+	double			m[3], lambda, R, E, *L, *m0;
+	int				r, j, k, count = 0;
+
+	if ( rows <= 0 || cols <= 0 )
+		return 0;
+
+	/* the day, as rise_tran_set_calendar computes it */
+	for ( k = 0; k < 3; ++k )
+		solar_coordinates_T(julian_centuries(JD + k - 1), &day.A[k], &day.D[k], &lambda, &R, &E);
+
+	day.A[0] = day.A[1] + revolution_180(day.A[0] - day.A[1]);
+	day.A[2] = day.A[1] + revolution_180(day.A[2] - day.A[1]);
+	day.theta0 = app_sidereal_time(JD);
+	day.deltaT = aa_get_auto_delta_t() ? delta_t(JD) : 0;
+	day.h0 = h0;
+	day.sinH0 = SinD(h0);
+
+	SinCosD(day.D[1], &raster.sinDelta, &raster.cosDelta);
+
+	/* the longitudes and the uncorrected transits of the columns, and the */
+	/* row states when state is NULL */
+	L = (double *) malloc(2 * (size_t) cols * sizeof(double) + (( state == NULL ) ? (size_t) rows : 0));
+	if ( L == NULL )
+		return 0;
+	m0 = L + cols;
+
+	for ( j = 0; j < cols; ++j )
+	{
+		L[j] = L0 + j * dL;
+		m0[j] = Normalize0To1((day.A[1] + L[j] - day.theta0) / 360.0);
+
+		/* the transit at the equator, the same at every latitude */
+		if ( transit != NULL )
+		{
+			rise_tran_set_site(L[j], 0, 1, h0, day.sinH0, day.theta0, day.deltaT, day.A, day.D, m);
+			transit[j] = m[0];
+		}
+	}
+
+	raster.kernel = raster_row[aa_get_isa()];
+	raster.day = &day;
+	raster.L = L;
+	raster.m0 = m0;
+	raster.phi0 = phi0;
+	raster.dphi = dphi;
+	raster.cols = cols;
+	raster.rise = rise;
+	raster.set = set;
+	raster.state = ( state != NULL ) ? state : (signed char *) (m0 + cols);
+
+	aa_parallel_for(rows, 1 + AA_PARALLEL_CELLS / cols, rise_set_rows, &raster);
+
+	for ( r = 0; r < rows; ++r )
+		count += ( raster.state[r] == rs_rises_sets );
+
+	free(L);
+
+	return count;
+}
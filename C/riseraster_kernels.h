@@ -0,0 +1,47 @@
+/* rise and set raster kernels, included once per instruction set */
+/* by riseraster.c through batchisa.h, no include guard */
+
+/* rising and setting along part of a latitude row, n <= RASTER_BLOCK cells with */
+/* the uncorrected transits m0[] and longitudes L[], H0 in degrees */
+static BATCH_TARGET void BATCH_NAME(rise_set_row)(const RiseSetDay *day, const double *m0, const double *L,
+	double H0, double sinPhi, double cosPhi, float * AA_RESTRICT rise, float * AA_RESTRICT set, int n)
+{
+	double	m[2][RASTER_BLOCK],		/* approximate times, rising and setting */
+			s[2][RASTER_BLOCK],		/* altitude */
+			d[2][RASTER_BLOCK];		/* denominator of the correction */
+	double	A0 = day->A[0], A1 = day->A[1], A2 = day->A[2],
+			D0 = day->D[0], D1 = day->D[1], D2 = day->D[2],
+			theta0 = day->theta0, dt = day->deltaT / 86400.0, h0 = day->h0;
+	int		e, i;
+
+	/* everything of rise_tran_set_site through the altitude, without branches or calls */
+	for ( e = 0; e < 2; ++e )
+		for ( i = 0; i < n; ++i )
+		{
+			double	x = m0[i] + ( e ? H0 : -H0 ) / 360.0,
+					f = x - ((x + TRIG_ROUND) - TRIG_ROUND),
+					t, nn, alpha, gamma, H, sinGamma, cosGamma, sinH, cosH;
+
+			t = f + ( ( f < 0.0 ) ? 1.0 : 0.0 );			/* Normalize0To1 */
+			nn = t + dt;
+
+			alpha = A1 + (nn / 2.0) * ( - A0 + A2 + nn * (A2 - A1 - A1 + A0) );
+			gamma = D1 + (nn / 2.0) * ( - D0 + D2 + nn * (D2 - D1 - D1 + D0) );
+
+			H = theta0 + 360.985647 * t - L[i] - alpha;
+			H = H - 360.0 * ((H * (1.0 / 360.0) + TRIG_ROUND) - TRIG_ROUND);	/* revolution_180 */
+
+			aa_sincosd_kernel(gamma, &sinGamma, &cosGamma);
+			aa_sincosd_kernel(H, &sinH, &cosH);
+
+			m[e][i] = t;
+			s[e][i] = aa_asind_kernel(sinPhi * sinGamma + cosPhi * cosGamma * cosH);
+			d[e][i] = 360.0 * cosGamma * cosPhi * sinH;
+		}
+
+	for ( i = 0; i < n; ++i )
+	{
+		rise[i] = (float) (m[0][i] + (s[0][i] - h0) / d[0][i]);
+		set[i] = (float) (m[1][i] + (s[1][i] - h0) / d[1][i]);
+	}
+}
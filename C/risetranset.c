@@ -1,9 +1,16 @@
 #include "astroalgo.h"
 #include "astromath.h"
+#include "astrointernal.h"
 
 /* C Headers */
 #include <math.h>
 
+#ifdef NAN
+	#define RTS_NAN			NAN
+#else
+	#define RTS_NAN			(HUGE_VAL - HUGE_VAL)
+#endif
+
 /* ---------------------------------------------------------------------------------
 	NAME:
 		RiseTranSet
@@ -37,7 +44,8 @@
 	 		transit, rising, setting time respectively of object
 	 			 
 	RETURNED VALUE:
-	 	0	error if the body is up all day or below the horizon all day
+	 	0	error if the body is up all day or below the horizon all day,
+	 		m[0] is still the transit
 	 	1	no error
 	 
 	GLOBALS USED:
@@ -45,7 +53,10 @@
 	 
 	FUNCTIONS CALLED:
 	 	MeanSiderealTime
+	 	delta_t
 	 	Normalize0To1
+	 	SinCosD
+	 	revolution_180
 	 	fabs
 	 
 	DATE/NOTE:
@@ -53,50 +64,159 @@
 		04-23-2001	added interpolation using JD-1, JD, JD+1
 	 	
 	NOTES:
-		Still need to calculate deltaT
-		minor error starting at interpolated theta values
-		off from Heavens Above by +/- 1 minute
+		deltaT is 0 unless aa_set_auto_delta_t() is on, then delta_t(JD)
+		rise_tran_set_obs takes L, phi and h0 from an aaObserver
+		A[] may pass through 360 degrees, A[0] and A[2] are taken within
+		180 degrees of A[1]
 		
 ----------------------------------------------------------------------------------*/
 int rise_tran_set(double L, double phi, double h0, double JD, double A[], double D[], double m[])
 {
-	double	theta0;			/* apparent sidereal time */
+	double	sinPhi, cosPhi;		/* latitude trig */
+	
+	SinCosD(phi, &sinPhi, &cosPhi);
+	
+	return rise_tran_set_site(L, sinPhi, cosPhi, h0, SinD(h0), app_sidereal_time(JD),
+		aa_get_auto_delta_t() ? delta_t(JD) : 0, A, D, m) == rs_rises_sets;
+}
+
+/* as rise_tran_set, for the site and horizon of the observer */
+int rise_tran_set_obs(const aaObserver *observer, double JD, double A[], double D[], double m[])
+{
+	return rise_tran_set_site(observer->L, observer->sinPhi, observer->cosPhi,
+		observer->horizon, observer->sinHorizon, app_sidereal_time(JD),
+		aa_get_auto_delta_t() ? delta_t(JD) : 0, A, D, m) == rs_rises_sets;
+}
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		rise_tran_set_calendar
+		
+	PURPOSE:
+		Computes the transit, rising and setting of the sun at a site for
+		every day of a range
+		
+	REFERENCES;
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 97-99, 151-153
+			
+	INPUT ARGUMENTS:
+		*observer (aaObserver)
+			the site, h0 -0.8333 for the sun
+		JD (double)
+			Julian Day at 0 hour UT of the first day
+		days (int)
+			number of days
+		
+	OUTPUT ARGUMENTS:
+	 	m[] (double)
+	 		transit, rising and setting of every day as fractions of the day
+	 		UT, 3 * days, rising and setting NaN on days without them
+	 	state[] (signed char)
+	 		RiseSetStates of every day, or NULL
+	 			 
+	RETURNED VALUE:
+	 	number of days the sun rises and sets
+	 
+	GLOBALS USED:
+	 	none
+	 
+	FUNCTIONS CALLED:
+	 	solar_coordinates_T, app_sidereal_time, delta_t, aa_get_auto_delta_t
+	 	
+	NOTES:
+		The sun is computed once a day at 0 hour TD and the three day window
+		of rise_tran_set_obs slides along, so every day costs one solar
+		position and one sidereal time instead of three and one.  Day i
+		gives what rise_tran_set_obs gives for JD + i with the coordinates
+		of app_solar_coordinates at 0 hour TD, including the transit on days
+		without rising and setting.
+		
+----------------------------------------------------------------------------------*/
+int rise_tran_set_calendar(const aaObserver *observer, double JD, int days, double m[], signed char state[])
+{
+	double	A[3], D[3];		/* the sun at 0 hour TD of the day before, the day and the day after */
+	double	lambda, R, E;
+	int		i, k, s, count = 0;
+	
+	/* the day before the first and the first, shifted down by the first step */
+	for ( k = 1; k < 3; ++k )
+		solar_coordinates_T(julian_centuries(JD + k - 2), &A[k], &D[k], &lambda, &R, &E);
+	
+	for ( i = 0; i < days; ++i )
+	{
+		/* slide the window a day */
+		A[0] = A[1];
+		D[0] = D[1];
+		A[1] = A[2];
+		D[1] = D[2];
+		solar_coordinates_T(julian_centuries(JD + i + 1), &A[2], &D[2], &lambda, &R, &E);
+		
+		s = rise_tran_set_site(observer->L, observer->sinPhi, observer->cosPhi,
+			observer->horizon, observer->sinHorizon, app_sidereal_time(JD + i),
+			aa_get_auto_delta_t() ? delta_t(JD + i) : 0, A, D, &m[3 * i]);
+		
+		if ( s == rs_rises_sets )
+			++count;
+		else
+			m[3 * i + 1] = m[3 * i + 2] = RTS_NAN;
+		
+		if ( state != NULL )
+			state[i] = (signed char) s;
+	}
+	
+	return count;
+}
+
+/* the computation of rise_tran_set with the latitude and h0 trig, the apparent */
+/* sidereal time at 0h UT and TD - UT in seconds given, returns a RiseSetStates */
+/* internal, declared in astrointernal.h */
+int rise_tran_set_site(double L, double sinPhi, double cosPhi, double h0, double sinHorizon,
+	double theta0, double deltaT, const double A[], const double D[], double m[])
+{
 	double	H0;				/* approximate time */
+	double	cosH0;			/* cosine of H0 */
 	double	theta[3];		/* array of sidereal times, transit, rising, setting  */
 	double	n[3];			/* interpolating factor, transit, rising, setting */
 	double	alpha[3];		/* right ascention correction factor */
 	double	gamma[3];		/* declination correction factor */
 	double	H[3];			/* local hour angle */
+	double	sinH[3], cosH;	/* hour angle trig */
 	double	h[3];			/* altitude */
-	double	deltaT;			/* TD - UT */
+	double	cosGamma[3];	/* interpolated declination cosine */
+	double	A0, A2;			/* A[0] and A[2] on the same turn as A[1] */
+	double	sinDelta, cosDelta;	/* declination trig on JD */
+	double	sinGamma;		/* interpolated declination sine */
+	int		count;			/* times computed, only the transit for a circumpolar body */
+	int		state;
 
 	
 	short	i = 0;			/* interpolation iterator */
 	
-	/* set deltaT to 0 for now */
-	deltaT = 0;
-	/* deltaT = 56.0; */
+	A0 = A[1] + revolution_180(A[0] - A[1]);
+	A2 = A[1] + revolution_180(A[2] - A[1]);
 	
-	/* get apparent sidereal time at greenwich at 0 hour Universal Time on JD */
-	theta0 = app_sidereal_time(JD);
-	/* theta0 = 177.74208; */
+	SinCosD(D[1], &sinDelta, &cosDelta);
 	
 	/* Make sure the body is not above or below the horizon all day */
-	/* if so, return 0 as an error bit */
-	if ( fabs(-SinD(phi) * SinD(D[1]) / CosD(phi) * CosD(D[1])) > 1 )
-		return 0;
+	cosH0 = (sinHorizon - sinPhi * sinDelta) / (cosPhi * cosDelta);
+	state = ( cosH0 > 1 ) ? rs_always_below : ( cosH0 < -1 ) ? rs_always_above : rs_rises_sets;
+	count = ( state == rs_rises_sets ) ? 3 : 1;
 	
 	/* Calculate approximate times, 14.1 */
-	H0 = acos((SinD(h0) - SinD(phi) * SinD(D[1])) / (CosD(phi) * CosD(D[1]))) * kRadDeg;
+	H0 = ( state == rs_rises_sets ) ? acos(cosH0) * kRadDeg : 0;
 	
 	/* calculate transit time */
 	m[0] = Normalize0To1( (A[1] + L - theta0) / 360.0 );
 		
 	/* calculate rise and set time */
-	m[1] = Normalize0To1(m[0] - H0 / 360.0);
-	m[2] = Normalize0To1(m[0] + H0 / 360.0);
+	if ( state == rs_rises_sets )
+	{
+		m[1] = Normalize0To1(m[0] - H0 / 360.0);
+		m[2] = Normalize0To1(m[0] + H0 / 360.0);
+	}
 	
-	for ( i = 0; i < 3; ++i)
+	for ( i = 0; i < count; ++i)
 	{
 		/* compute the sidereal time */
 		theta[i] = theta0 + 360.985647 * m[i];
@@ -106,42 +226,26 @@ int rise_tran_set(double L, double phi, double h0, double JD, double A[], double
 		n[i] = m[i] + (deltaT / 86400.0);
 		
 		/* interpolate alpha and gamma from input, 3.3 */
-		alpha[i] = A[1] + (n[i]/2.0) * ( - A[0] + A[2] + n[i]*(A[2] - A[1] - A[1] + A[0]) );
+		alpha[i] = A[1] + (n[i]/2.0) * ( - A0 + A2 + n[i]*(A2 - A[1] - A[1] + A0) );
 		gamma[i] = D[1] + (n[i]/2.0) * ( - D[0] + D[2] + n[i]*(D[2] - D[1] - D[1] + D[0]) );
 		
 		/* calculate local hour angle */
 		H[i] = revolution_180(theta[i] - L - alpha[i]);
 		
 		/* calculate altitude, 12.6 */
-		h[i] = asin( SinD(phi) * SinD(gamma[i]) + CosD(phi) * CosD(gamma[i]) * CosD(H[i]) ) * kRadDeg;
+		SinCosD(gamma[i], &sinGamma, &cosGamma[i]);
+		SinCosD(H[i], &sinH[i], &cosH);
+		h[i] = asin( sinPhi * sinGamma + cosPhi * cosGamma[i] * cosH ) * kRadDeg;
 	}
 	
-	/* make corrections */
+	/* make corrections, the angles are in degrees */
 	m[0] = m[0] + ( - H[0] / 360.0 );
-	m[1] = m[1] + (h[1] - h0) / (360 * cos(gamma[1]) * cos(phi) * sin(H[1]));
-	m[2] = m[2] + (h[2] - h0) / (360 * cos(gamma[2]) * cos(phi) * sin(H[2]));
 	
-	/* print results
-	printf("theta0 = %f\n", theta0);
-	printf("H0 = %f\n", H0);
-	printf("theta = %f %f %f\n", theta[0], theta[1], theta[2]);
-	printf("n = %f %f %f\n", n[0], n[1], n[2]);
-	printf("alpha = %f %f %f\n", alpha[0], alpha[1], alpha[2]);
-	printf("gamma = %f %f %f\n", gamma[0], gamma[1], gamma[2]);
-	printf("H = %f %f %f\n", H[0], H[1], H[2]);
-	printf("h = %f %f %f\n", h[0], h[1], h[2]);
-	printf("m = %f %f %f\n", m[0], m[1], m[2]);
-	*/
+	if ( state == rs_rises_sets )
+	{
+		m[1] = m[1] + (h[1] - h0) / (360 * cosGamma[1] * cosPhi * sinH[1]);
+		m[2] = m[2] + (h[2] - h0) / (360 * cosGamma[2] * cosPhi * sinH[2]);
+	}
 
-	return 1;
+	return state;
 }
-
-
-
-
-
-
-
-
-
-
@@ -1,5 +1,6 @@
 #include "astroalgo.h"
 #include "astromath.h"
+#include "astrointernal.h"
 
 /* ---------------------------------------------------------------------------------
 	NAME:
@@ -45,6 +46,21 @@ double mean_sidereal_time(double JD)
 	return Revolution(280.46061837 + 360.98564736629 * (JD - 2451545.0) + 0.000387933 * T * T - (T * T * T)/38710000.0);
 }
 
+/* nutation in right ascension in degrees, apparent less mean sidereal time */
+static double equation_of_equinoxes(double T)
+{
+	double	deltaPsi,		/* nutation in longitude */
+			deltaEpsilon,	/* nutation of obliquity */
+			epsilon,		/* true obliquity of the ecliptic */
+			epsilonNull,	/* mean obliquity of the ecliptic */
+			sinEpsilon, cosEpsilon;
+	
+	nutation_obliquity(T, &deltaPsi, &deltaEpsilon, &epsilon, &epsilonNull);
+	SinCosD(epsilon, &sinEpsilon, &cosEpsilon);
+	
+	return deltaPsi / 15.0 * cosEpsilon / 240.0;
+}
+
 /* ---------------------------------------------------------------------------------
 	NAME:
 		AppSiderealTime
@@ -71,25 +87,77 @@ double mean_sidereal_time(double JD)
 	 	none
 	 
 	FUNCTIONS CALLED:
-		Nutation
-		Obliquity
+		nutation_obliquity, ut_to_tt, aa_get_auto_delta_t
 	 
 	DATE/PROGRAMMER:
 	 	07-17-2000	Todd A. Guillory	created
 	 	07-26-2000	Todd A. Guillory	correct results with example 11.a
 	 	
 	NOTES:
+		The nutation is a function of Dynamical Time, it is taken at
+		ut_to_tt(JD) when aa_set_auto_delta_t() is on, at JD otherwise.
 		
 ----------------------------------------------------------------------------------*/
 double app_sidereal_time(double JD)
 {
-	double	deltaPsi,		/* nutation in longitude */
-			deltaEpsilon,	/* nutation of obliquity */
-			epsilon,		/* true obliquity of the ecliptic */
-			epsilonNull;	/* mean obliquity of the ecliptic */
+	return mean_sidereal_time(JD)
+		+ equation_of_equinoxes(julian_centuries(aa_get_auto_delta_t() ? ut_to_tt(JD) : JD));
+}
+
+/* ---------------------------------------------------------------------------------
+	NAME:
+		mean_sidereal_time_instant
+		app_sidereal_time_instant
+		
+	PURPOSE:
+		MeanSiderealTime and AppSiderealTime for an aaInstant
+		
+	REFERENCES;
+		Meeus, Jean. "Astronomical Algorithms, 1st ed." Willmann-Bell. Inc. 1991.
+			pp. 83-84
+			
+	INPUT ARGUMENTS:
+		t (aaInstant)
+			instant UT
+	
+	OUTPUT ARGUMENTS:
+	 	none
+	 
+	RETURNED VALUE:
+	 	mean or apparent sidereal time at the meridian of Greenwich (double) in
+	 	degrees
+	 
+	GLOBALS USED:
+	 	none
+	 
+	FUNCTIONS CALLED:
+		instant_centuries, Revolution, nutation_obliquity, delta_t,
+		aa_get_auto_delta_t
+	 	
+	NOTES:
+		360.98564736629 degrees a day is a whole turn plus 0.98564736629, the
+		whole turns of the integer days are dropped before they cost digits.
+		The result keeps about 1e-10 degrees for any time of day within a few
+		centuries of J2000.0.  The Julian Day form loses that to the
+		resolution of the Julian Day, about 2e-7 degrees in 2024.
+		
+----------------------------------------------------------------------------------*/
+double mean_sidereal_time_instant(aaInstant t)
+{
+	double	T = instant_centuries(t),
+			f = (double) t.ns / 86400000000000.0;		/* fraction of the day */
+	
+	return Revolution(280.46061837 + 0.98564736629 * (double) t.day + 360.98564736629 * f
+		+ 0.000387933 * T * T - (T * T * T)/38710000.0);
+}
+
+double app_sidereal_time_instant(aaInstant t)
+{
+	double	T = instant_centuries(t);
 	
-	nutation(julian_centuries(JD), &deltaPsi, &deltaEpsilon);
-	obliquity(julian_centuries(JD), &epsilon, &epsilonNull);
+	/* the nutation at TD as app_sidereal_time takes it */
+	if ( aa_get_auto_delta_t() )
+		T += delta_t(instant_to_julian(t)) / (86400.0 * 36525.0);
 	
-	return mean_sidereal_time(JD) + deltaPsi / 15.0 * CosD(epsilon) / 240.0;
+	return mean_sidereal_time_instant(t) + equation_of_equinoxes(T);
 }
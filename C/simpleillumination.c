@@ -1,9 +1,12 @@
 #include "astroalgo.h"
 #include "astromath.h"
+#include "astrointernal.h"
 
 /* C Headers */
 #include <math.h>
 
+static double illumination( double D, double M, double Mprime );
+
 /*******************************************************************************
 *	NAME:
 *		SimpleIllumination
@@ -30,24 +33,32 @@
 *	 	none
 *	 
 *	FUNCTIONS CALLED:
-*	 	SinD, CosD, Revolution, atan2
+*	 	SinD, CosD, Revolution, atan2, ut_to_tt, aa_get_auto_delta_t
 *	 
 *	DATE/PROGRAMMER/NOTE:
 *	 	07-31-2001	Todd A. Guillory	created
 *
+*	NOTES:
+*		inJulian is UT when aa_set_auto_delta_t() is on, and is converted
+*		with ut_to_tt() as app_solar_coordinates() does.
+*
 ********************************************************************************/
 double simple_illumination( double inJulian )
 {
-	double	k;		/* illuminated fraction of moon's disc */
-	double	T;		/* Julian Centuries */
-	double	i;		/* phase angle of the moon */
+	if ( aa_get_auto_delta_t() )
+		inJulian = ut_to_tt(inJulian);
+	
+	/* pg. 131 */
+	return simple_illumination_T(( inJulian - 2451545.0) / 36525.0);
+}
+
+/* the same for T Julian centuries TD, whatever aa_set_auto_delta_t() says */
+double simple_illumination_T( double T )
+{
 	double	D;		/* mean elogation of the moon */
 	double	M;		/* sun's mean anomaly */
 	double	Mprime;	/* moon's mean anomaly */
 
-	/* pg. 131 */
-	T =  ( inJulian - 2451545.0) / 36525.0;
-  
 	D = 297.8502042 + (445267.1115168 * T) 
                     - (0.0016300 * T * T) 
                     + ((T * T * T)/545868) 
@@ -62,10 +73,21 @@ double simple_illumination( double inJulian )
                          + ((T * T * T)/69699) 
                          - ((T * T * T * T)/14712000);
   
-	D = fmod(D, 360.0);
-	M = fmod(M, 360.0);
-	Mprime = fmod(Mprime, 360.0);
-  
+	return illumination(fmod(D, 360.0), fmod(M, 360.0), fmod(Mprime, 360.0));
+}
+
+/* as simple_illumination, the fundamental arguments from the epoch */
+double simple_illumination_ctx( const aaEpoch *epoch )
+{
+	return illumination(epoch->D, epoch->M, epoch->Mprime);
+}
+
+/* illuminated fraction from D, M and M' in degrees */
+static double illumination( double D, double M, double Mprime )
+{
+	double	k;		/* illuminated fraction of moon's disc */
+	double	i;		/* phase angle of the moon */
+
  	M = kDegRad * M;
 	Mprime = kDegRad * Mprime;
   
@@ -0,0 +1,322 @@
+#include "astroalgo.h"
+#include "astrointernal.h"
+
+/* C Headers */
+#include <math.h>
+
+/* Julian Day of the Unix epoch, 1970-01-01T00:00:00Z */
+#define UNIX_EPOCH_JD		2440587.5
+
+/* Julian Day written for text that is not a timestamp */
+#ifdef NAN
+	#define TP_NAN			NAN
+#else
+	#define TP_NAN			(HUGE_VAL - HUGE_VAL)
+#endif
+
+/* timestamps are separated by white space, commas or semicolons */
+#define TP_SEPARATOR(c)		( tp_separator[(unsigned char) (c)] )
+
+/* value of a decimal digit, more than 9 for any other character */
+#define TP_DIGIT(c)			( (unsigned char) ((c) - '0') )
+
+static const unsigned char	tp_separator[256] =
+{
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0,		/* \t \n \r */
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,		/* space , */
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0		/* ; */
+};
+
+static const unsigned char	tp_month_days[13] = { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+/* two digits at p, more than 99 if either is not a digit */
+#define TP_TWO(p)			( TP_DIGIT((p)[0]) * 10u + TP_DIGIT((p)[1]) + ( (TP_DIGIT((p)[0]) > 9) | (TP_DIGIT((p)[1]) > 9) ) * 1000u )
+
+/* fraction of a second after the decimal point, to the first non digit, */
+/* digits past nanoseconds are read and ignored */
+static const unsigned char *tp_fraction(const unsigned char *p, const unsigned char *end, double *fraction)
+{
+	static const long	scale[10] = { 0, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+	const unsigned char	*start = p;
+	long				ns = 0;
+	int					n = 0;
+
+	for ( ; p < end && TP_DIGIT(*p) <= 9; ++p )
+		if ( ++n <= 9 )
+			ns += TP_DIGIT(*p) * scale[n];
+
+	if ( p == start )
+		return NULL;
+
+	*fraction = ns * 1.0e-9;
+	return p;
+}
+
+/* ISO 8601 extended format, YYYY-MM-DD[Thh:mm[:ss[.fff]]][Z|+hh[:mm]|-hh[:mm]] */
+/* returns the end of the time stamp, NULL if p does not start one */
+static const unsigned char *tp_iso8601(const unsigned char *p, const unsigned char *end, double *JD)
+{
+	unsigned	year, month, day, hour = 0, minute = 0, second = 0, oh, om = 0;
+	long		offset = 0;
+	double		fraction = 0;
+
+	year = TP_TWO(p) * 100 + TP_TWO(p + 2);
+	month = TP_TWO(p + 5);
+	day = TP_TWO(p + 8);
+
+	if ( year > 9999 || p[7] != '-' || month - 1 > 11 || day - 1 >= tp_month_days[month] )
+		return NULL;
+	if ( month == 2 && day == 29 && ( year % 4 != 0 || (year % 100 == 0 && year % 400 != 0) ) )
+		return NULL;
+	p += 10;
+
+	if ( p < end && (*p == 'T' || *p == 't') )
+	{
+		if ( end - p < 6 || p[3] != ':' )
+			return NULL;
+
+		hour = TP_TWO(p + 1);
+		minute = TP_TWO(p + 4);
+		p += 6;
+
+		if ( p < end && *p == ':' )
+		{
+			if ( end - p < 3 )
+				return NULL;
+			second = TP_TWO(p + 1);
+			p += 3;
+
+			if ( p < end && *p == '.' )
+				if ( (p = tp_fraction(p + 1, end, &fraction)) == NULL )
+					return NULL;
+		}
+
+		/* 24:00:00 is midnight at the end of the day, 60 a leap second */
+		if ( hour > 24 || minute > 59 || second > 60 ||
+			 ( hour == 24 && (minute > 0 || second > 0 || fraction > 0) ) )
+			return NULL;
+
+		if ( p < end && (*p == 'Z' || *p == 'z') )
+			++p;
+		else if ( p < end && (*p == '+' || *p == '-') )
+		{
+			if ( end - p < 3 || (oh = TP_TWO(p + 1)) > 23 )
+				return NULL;
+			offset = ( *p == '-' ) ? -1 : 1;
+			p += 3;
+
+			/* +hh:mm, a colon must be followed by the minutes, or +hhmm */
+			if ( p < end && *p == ':' )
+			{
+				if ( end - p < 3 || (om = TP_TWO(p + 1)) > 59 )
+					return NULL;
+				p += 3;
+			}
+			else if ( end - p >= 2 && TP_DIGIT(*p) <= 9 )
+			{
+				if ( (om = TP_TWO(p)) > 59 )
+					return NULL;
+				p += 2;
+			}
+
+			offset *= oh * 60 + om;
+		}
+	}
+
+	/* ISO 8601 dates are proleptic Gregorian, before 1582 too */
+	*JD = ( (double) (aa_calendar_days(year, month) + day + aa_gregorian_days(year, month)) - 1524.5 )
+		+ ( (double) ((long) (hour * 3600 + minute * 60 + second) - offset * 60) + fraction ) / 86400.0;
+
+	return p;
+}
+
+/* Unix time, [+|-]seconds[.fff] since 1970-01-01T00:00:00Z */
+/* returns the end of the time stamp, NULL if p does not start one */
+static const unsigned char *tp_unix(const unsigned char *p, const unsigned char *end, double *JD)
+{
+	const unsigned char	*start;
+	long long			seconds = 0, days;
+	double				fraction = 0;
+	int					negative = 0;
+
+	if ( p < end && (*p == '+' || *p == '-') )
+		negative = ( *p++ == '-' );
+
+	/* up to 18 digits fit a 64 bit integer, a 19th is refused before it is added */
+	for ( start = p; p < end && TP_DIGIT(*p) <= 9; ++p )
+	{
+		if ( p - start == 18 )
+			return NULL;
+
+		seconds = seconds * 10 + TP_DIGIT(*p);
+	}
+
+	if ( p == start )
+		return NULL;
+
+	if ( p < end && *p == '.' )
+		if ( (p = tp_fraction(p + 1, end, &fraction)) == NULL )
+			return NULL;
+
+	if ( negative )
+	{
+		seconds = -seconds;
+		fraction = -fraction;
+	}
+
+	/* whole days apart from the seconds of the day keeps the sum exact */
+	days = seconds / 86400 - ( seconds % 86400 < 0 );
+	seconds -= days * 86400;
+
+	*JD = ( UNIX_EPOCH_JD + (double) days ) + ( (double) seconds + fraction ) / 86400.0;
+
+	return p;
+}
+
+/* either format, four digits and a dash start a date */
+static const unsigned char *tp_timestamp(const unsigned char *p, const unsigned char *end, double *JD)
+{
+	if ( end - p >= 10 && p[4] == '-' && TP_DIGIT(p[0]) <= 9 )
+		return tp_iso8601(p, end, JD);
+
+	return tp_unix(p, end, JD);
+}
+
+/*******************************************************************************
+	NAME:
+		timestamp_to_julian
+
+	PURPOSE:
+		Converts one ISO 8601 or Unix time stamp to a Julian Day
+
+	REFERENCES:
+		ISO 8601-1:2019, Date and time, Part 1: Basic rules
+
+	INPUT ARGUMENTS:
+		text (const char *)
+			time stamp, not NUL terminated
+		length (size_t)
+			number of characters
+
+	OUTPUT ARGUMENTS:
+		*JD (double)
+			Julian Day UT, unchanged when the text is not a time stamp
+
+	RETURNED VALUE:
+		1 if the text is a time stamp, 0 if not
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		aa_calendar_days, aa_gregorian_days
+
+	NOTES:
+		ISO 8601 extended format with a four digit year:
+			2024-03-01
+			2024-03-01T12:30
+			2024-03-01T12:30:15.250Z
+			2024-03-01T12:30:15+02:00, +0200 or +02
+		Time stamps without a zone are taken as UT.  The calendar is the
+		proleptic Gregorian one ISO 8601 prescribes, so dates before
+		1582-10-15 differ from date_to_julian, which switches to the Julian
+		calendar.
+
+		Unix time is decimal seconds, optionally signed and with a fraction,
+		leap seconds not counted: 1709296215.25
+
+		Fractions are read to the nanosecond.
+
+********************************************************************************/
+int timestamp_to_julian(const char *text, size_t length, double *JD)
+{
+	const unsigned char	*end = (const unsigned char *) text + length;
+	double				value;
+
+	/* a prefix that parses is not the whole text, nothing is written for it */
+	if ( tp_timestamp((const unsigned char *) text, end, &value) != end )
+		return 0;
+
+	*JD = value;
+	return 1;
+}
+
+/*******************************************************************************
+	NAME:
+		timestamps_to_julian
+
+	PURPOSE:
+		Converts a buffer of time stamps to Julian Days in place, without
+		copying or allocating, and in pieces for streamed input
+
+	REFERENCES:
+		none
+
+	INPUT ARGUMENTS:
+		text (const char *)
+			time stamps separated by white space, commas or semicolons
+		length (size_t)
+			number of characters in the buffer
+		final (int)
+			0 if more text follows in a later call, 1 for the last piece
+		maxJD (int)
+			room in JD[]
+
+	OUTPUT ARGUMENTS:
+		JD[] (double)
+			Julian Days UT, NaN for text that is not a time stamp
+		*consumed (size_t)
+			characters used, the next call starts at text + *consumed
+
+	RETURNED VALUE:
+		number of Julian Days written
+
+	GLOBALS USED:
+		none
+
+	FUNCTIONS CALLED:
+		none
+
+	NOTES:
+		Without final a time stamp that runs to the end of the buffer may
+		be cut off, it is left unconsumed and is converted by the next call
+		once the caller has appended the rest.  The call also stops when
+		JD[] is full.  See timestamp_to_julian for the formats.
+
+********************************************************************************/
+int timestamps_to_julian(const char *text, size_t length, int final, double *JD, int maxJD, size_t *consumed)
+{
+	const unsigned char	*p = (const unsigned char *) text;
+	const unsigned char	*end = p + length;
+	const unsigned char	*next;
+	int					count = 0;
+
+	while ( count < maxJD )
+	{
+		while ( p < end && TP_SEPARATOR(*p) )
+			++p;
+
+		if ( p == end )
+			break;
+
+		/* parse in one pass, the time stamp must end at a separator */
+		next = tp_timestamp(p, end, &JD[count]);
+
+		if ( next == NULL || (next < end && !TP_SEPARATOR(*next)) )
+		{
+			for ( next = p; next < end && !TP_SEPARATOR(*next); ++next )
+				;
+			JD[count] = TP_NAN;
+		}
+
+		if ( next == end && !final )
+			break;
+
+		p = next;
+		++count;
+	}
+
+	*consumed = (size_t) (p - (const unsigned char *) text);
+	return count;
+}
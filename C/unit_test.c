@@ -1,4 +1,7 @@
 #include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "astroalgo.h"
 
@@ -6,12 +9,42 @@ void day_of_week_test();
 void first_week_day_test();
 void date2julian_test();
 void date2julian_test();
+void nutation_test();
+void instant_test();
+void delta_t_test();
+void rise_tran_set_test();
+void solar_record_test();
+void calendar_test();
+void batch_solar_test();
+void ephemeris_test();
+void rise_set_raster_test();
+void altitude_raster_test();
+void horizontal_batch_test();
+void solar_geometry_test();
+void poles_test();
+void batch_calendar_test();
+void timestamp_test();
 
 int main(void)
 {
 	day_of_week_test();
 	first_week_day_test();
 	date2julian_test();
+	nutation_test();
+	instant_test();
+	delta_t_test();
+	rise_tran_set_test();
+	solar_record_test();
+	calendar_test();
+	batch_solar_test();
+	ephemeris_test();
+	rise_set_raster_test();
+	altitude_raster_test();
+	horizontal_batch_test();
+	solar_geometry_test();
+	poles_test();
+	batch_calendar_test();
+	timestamp_test();
 
 	return 0;
 }
@@ -34,3 +67,488 @@ void date2julian_test()
 	int code = date_to_julian(1,1,2008,&jd);
 	printf("Julian Day is %f\n", jd );
 }
+
+void nutation_test()
+{
+	double deltaPsi = 0, deltaEpsilon = 0;
+	/* example 21.a, 1987 April 10 0h TD: -3".788 and +9".443 */
+	nutation(julian_centuries(2446895.5), &deltaPsi, &deltaEpsilon);
+	printf("deltaPsi is %f, deltaEpsilon is %f\n", deltaPsi, deltaEpsilon );
+
+	/* IAU 2000B on 2006 January 1 0h TT: -1".986857 and +8".380946 */
+	nutation_set_model(nutation_iau2000b);
+	nutation(julian_centuries(2453736.5), &deltaPsi, &deltaEpsilon);
+	nutation_set_model(nutation_meeus);
+	printf("IAU 2000B deltaPsi is %f, deltaEpsilon is %f\n", deltaPsi, deltaEpsilon );
+}
+
+void instant_test()
+{
+	/* example 12.b, 1987 April 10 19h21m00s UT: 128.7378734 degrees */
+	aaInstant t = instant_add(julian_to_instant(2446895.5), 0, (19 * 3600 + 21 * 60) * 1000000000LL);
+	printf("mean sidereal time is %.7f\n", mean_sidereal_time_instant(t) );
+}
+
+void delta_t_test()
+{
+	/* example 10.a, 1977 February 18: about 48 seconds */
+	printf("DeltaT is %.1f\n", delta_t(2443192.5) );
+}
+
+void rise_tran_set_test()
+{
+	/* example 15.a, Venus at Boston 1988 March 20: 0.81980, 0.51766, 0.12130 */
+	double A[3] = { 40.68021, 41.73129, 42.78204 }, D[3] = { 18.04761, 18.44092, 18.82742 }, m[3];
+	aaObserver boston;
+	
+	observer_init(&boston, 71.0833, 42.3333, 0, -0.5667);
+	aa_set_auto_delta_t(1);
+	rise_tran_set_obs(&boston, 2447240.5, A, D, m);
+	aa_set_auto_delta_t(0);
+	printf("transit %.5f, rise %.5f, set %.5f\n", m[0], m[1], m[2] );
+}
+
+void solar_record_test()
+{
+	/* example 27.a, 1992 October 13 0h TD: 13m42.6s */
+	aaSolarRecord record;
+	aaEpoch epoch;
+	double JD, alpha, delta, a, d;
+	int wrong = 0;
+	
+	aa_solar_record(2448908.5, 0, &record);
+	printf("equation of time is %.2f minutes, R is %.5f\n", record.E, record.R );
+	
+	/* the epoch gives the coordinates of app_solar_coordinates bit for bit */
+	for ( JD = 2415020.5; JD < 2488070.5; JD += 37.3 )
+	{
+		epoch_init(&epoch, JD);
+		app_solar_coordinates_ctx(&epoch, &alpha, &delta);
+		app_solar_coordinates(JD, &a, &d);
+		wrong += ( alpha != a || delta != d );
+	}
+	printf("epoch solar coordinates: %d wrong\n", wrong );
+}
+
+void calendar_test()
+{
+	/* the sun at Tromso in 2024, polar night until mid January, midnight sun */
+	/* late May to late July: 248 days with sunrise and sunset */
+	static double m[3 * 366];
+	aaObserver tromso;
+	
+	observer_init(&tromso, -18.95, 69.65, 0, -0.8333);
+	printf("days with sunrise and sunset %d\n", rise_tran_set_calendar(&tromso, 2460310.5, 366, m, NULL) );
+}
+
+/* largest difference of two angles in degrees */
+static double angle_error(double a, double b, double error)
+{
+	double d = fabs(a - b);
+	
+	if ( d > 180 )
+		d = 360 - d;
+	return ( d > error ) ? d : error;
+}
+
+void batch_solar_test()
+{
+	/* app_solar_coordinates_n and _grid against app_solar_coordinates at every */
+	/* instruction set, 2000 to 2010 every 3.7 days: within 1e-12 degrees */
+	static double JD[1000], alpha[1000], delta[1000], ga[1000], gd[1000];
+	IsaLevels isa = aa_get_isa(), level;
+	double a, d, error = 0;
+	int i;
+	
+	for ( i = 0; i < 1000; ++i )
+		JD[i] = 2451545.0 + i * 3.7;
+	
+	for ( level = isa_scalar; level <= isa_avx512; ++level )
+	{
+		if ( !aa_set_isa(level) )
+			continue;
+		
+		app_solar_coordinates_n(JD, alpha, delta, NULL, NULL, 1000);
+		app_solar_coordinates_grid(JD[0], 3.7, 1000, ga, gd, NULL, NULL);
+		
+		for ( i = 0; i < 1000; ++i )
+		{
+			app_solar_coordinates(JD[i], &a, &d);
+			error = angle_error(alpha[i], a, error);
+			error = angle_error(delta[i], d, error);
+			error = angle_error(ga[i], a, error);
+			error = angle_error(gd[i], d, error);
+		}
+	}
+	aa_set_isa(isa);
+	
+	printf("batch solar coordinates %s\n", ( error < 1e-12 ) ? "agree" : "differ" );
+}
+
+void ephemeris_test()
+{
+	/* a compiled, opened and queried ephemeris against the series for 2024 */
+	/* January and February: within 1e-9 degrees, a truncated copy refused */
+	static char buffer[8192];
+	aaEphemeris eph;
+	double JD, alpha, delta, a, d, psi, eps, p, e, error = 0, arcseconds, seconds;
+	FILE *in, *out;
+	size_t size;
+	int opened, refused;
+	
+	if ( !ephemeris_compile("unit_test.eph", 2460310.5, 60, 4, 13) || !ephemeris_open(&eph, "unit_test.eph") )
+	{
+		printf("ephemeris not compiled\n");
+		return;
+	}
+	
+	for ( JD = 2460310.5; JD < 2460370.5; JD += 0.37 )
+	{
+		ephemeris_solar_coordinates(&eph, JD, &alpha, &delta);
+		app_solar_coordinates(JD, &a, &d);
+		error = angle_error(alpha, a, error);
+		error = angle_error(delta, d, error);
+		
+		ephemeris_nutation(&eph, (JD - 2451545.0) / 36525.0, &psi, &eps);
+		nutation((JD - 2451545.0) / 36525.0, &p, &e);
+		error = angle_error(psi / 3600, p / 3600, error);
+		error = angle_error(eps / 3600, e / 3600, error);
+	}
+	opened = ( error < 1e-9 );
+	
+	/* another tolerance is not the file's, the series is used */
+	aa_get_tolerance(&arcseconds, &seconds);
+	aa_set_tolerance(0.5, seconds);
+	ephemeris_nutation(&eph, 0.24, &psi, &eps);
+	nutation(0.24, &p, &e);
+	aa_set_tolerance(arcseconds, seconds);
+	opened &= ( psi == p && eps == e );
+	ephemeris_close(&eph);
+	
+	/* the header and part of the first segment */
+	in = fopen("unit_test.eph", "rb");
+	out = fopen("unit_test_short.eph", "wb");
+	size = ( in != NULL ) ? fread(buffer, 1, 200, in) : 0;
+	if ( out != NULL )
+	{
+		fwrite(buffer, 1, size, out);
+		fclose(out);
+	}
+	if ( in != NULL )
+		fclose(in);
+	refused = !ephemeris_open(&eph, "unit_test_short.eph");
+	
+	remove("unit_test.eph");
+	remove("unit_test_short.eph");
+	
+	printf("ephemeris %s, truncated file %s\n", opened ? "agrees" : "differs", refused ? "refused" : "opened" );
+}
+
+void rise_set_raster_test()
+{
+	/* rise_tran_set_raster against rise_tran_set for every cell and instruction */
+	/* set on 2024 June 20, pole to pole: the same masks, rise and set within */
+	/* the rounding to float */
+	static float rise[37 * 72], set[37 * 72];
+	double transit[72], A[3], D[3], m[3], d, error = 0;
+	signed char state[37];
+	IsaLevels isa = aa_get_isa(), level;
+	int r, j, k, ok, mismatches = 0;
+	
+	for ( level = isa_scalar; level <= isa_avx512; ++level )
+	{
+		if ( !aa_set_isa(level) )
+			continue;
+		
+		rise_tran_set_raster(2460481.5, -0.8333, -90, 5, 37, -180, 5, 72, rise, set, transit, state);
+		
+		for ( r = 0; r < 37; ++r )
+			for ( j = 0; j < 72; ++j )
+			{
+				for ( k = 0; k < 3; ++k )
+					app_solar_coordinates(2460481.5 + k - 1, &A[k], &D[k]);
+				
+				ok = rise_tran_set(-180 + j * 5, -90 + r * 5, -0.8333, 2460481.5, A, D, m);
+				mismatches += ( ok != ( state[r] == 1 ) );
+				error = ( fabs(transit[j] - m[0]) > error ) ? fabs(transit[j] - m[0]) : error;
+				if ( !ok )
+					continue;
+				
+				/* a time near midnight may come out on the other side of it */
+				d = fabs(rise[r * 72 + j] - m[1]);
+				d = ( d > 0.5 ) ? 1 - d : d;
+				error = ( d > error ) ? d : error;
+				d = fabs(set[r * 72 + j] - m[2]);
+				d = ( d > 0.5 ) ? 1 - d : d;
+				error = ( d > error ) ? d : error;
+			}
+	}
+	aa_set_isa(isa);
+	
+	printf("rise and set raster %d mask mismatches, %s\n", mismatches, ( error < 6e-8 ) ? "agrees" : "differs" );
+}
+
+void altitude_raster_test()
+{
+	/* solar_altitude_raster against azimuth_altitude for every cell and */
+	/* instruction set: within 1e-12 degrees, a NULL altitude refused */
+	static double h[35 * 72], A[35 * 72];
+	double alpha, delta, a, e, error = 0;
+	IsaLevels isa = aa_get_isa(), level;
+	int r, j, refused;
+	
+	app_solar_coordinates(2460400.3, &alpha, &delta);
+	
+	for ( level = isa_scalar; level <= isa_avx512; ++level )
+	{
+		if ( !aa_set_isa(level) )
+			continue;
+		
+		solar_altitude_raster(2460400.3, -85, 5, 35, -180, 5, 72, h, A);
+		
+		for ( r = 0; r < 35; ++r )
+			for ( j = 0; j < 72; ++j )
+			{
+				azimuth_altitude(2460400.3, alpha, delta, -180 + j * 5, -85 + r * 5, &a, &e);
+				error = angle_error(A[r * 72 + j], a, error);
+				error = angle_error(h[r * 72 + j], e, error);
+			}
+	}
+	aa_set_isa(isa);
+	
+	refused = !solar_altitude_raster(2460400.3, -85, 5, 35, -180, 5, 72, NULL, A)
+		&& !solar_altitude_raster_f(2460400.3, -85, 5, 35, -180, 5, 72, NULL, NULL);
+	
+	printf("altitude raster %s, NULL altitude %s\n", ( error < 1e-12 ) ? "agrees" : "differs", refused ? "refused" : "written" );
+}
+
+void horizontal_batch_test()
+{
+	/* azimuth_altitude_n against azimuth_altitude over the whole sky from */
+	/* Boston, the poles included, at every instruction set: within 1e-12 degrees */
+	static double alpha[37 * 72], delta[37 * 72], A[37 * 72], h[37 * 72];
+	double a, e, error = 0;
+	IsaLevels isa = aa_get_isa(), level;
+	int i;
+	
+	for ( i = 0; i < 37 * 72; ++i )
+	{
+		alpha[i] = (i % 72) * 5;
+		delta[i] = -90 + (i / 72) * 5;
+	}
+	
+	for ( level = isa_scalar; level <= isa_avx512; ++level )
+	{
+		if ( !aa_set_isa(level) )
+			continue;
+		
+		azimuth_altitude_n(2460400.3, alpha, delta, 71.0833, 42.3333, A, h, 37 * 72);
+		
+		for ( i = 0; i < 37 * 72; ++i )
+		{
+			azimuth_altitude(2460400.3, alpha[i], delta[i], 71.0833, 42.3333, &a, &e);
+			error = angle_error(A[i], a, error);
+			error = angle_error(h[i], e, error);
+		}
+	}
+	aa_set_isa(isa);
+	
+	printf("batch horizontal coordinates %s\n", ( error < 1e-12 ) ? "agree" : "differ" );
+}
+
+void solar_geometry_test()
+{
+	/* solar_geometry_grid against app_solar_coordinates, azimuth_altitude and */
+	/* the incidence of Duffie and Beckman 1.6.3 at every instruction set: the */
+	/* angles within 1e-8 degrees, the irradiance within 1e-9 W/m^2 of 1361/R^2 */
+	static const double L[4] = { 71.0833, -2.35, 0, -151.2 },
+		phi[4] = { 42.3333, 48.8667, -80, -33.8667 },
+		tilt[4] = { 30, 90, 0, 45 }, gamma[4] = { 0, -90, 0, 180 };
+	static double zenith[4 * 300], A[4 * 300], cosIncidence[4 * 300], E0[300];
+	const double rad = 3.14159265358979323846 / 180;
+	double JD, alpha, delta, a, h, c, angle = 0, incidence = 0, irradiance = 0;
+	aaSolarRecord record;
+	IsaLevels isa = aa_get_isa(), level;
+	int s, t, failed = 0;
+	
+	for ( level = isa_scalar; level <= isa_avx512; ++level )
+	{
+		if ( !aa_set_isa(level) )
+			continue;
+		
+		failed |= !solar_geometry_grid(2460481.5, 1.0 / 288, 300, L, phi, tilt, gamma, 4,
+			zenith, A, cosIncidence, E0);
+		
+		for ( t = 0; t < 300; ++t )
+		{
+			JD = 2460481.5 + t * (1.0 / 288);
+			app_solar_coordinates(JD, &alpha, &delta);
+			aa_solar_record(JD, 0, &record);
+			irradiance = fmax(irradiance, fabs(E0[t] - 1361.0 / (record.R * record.R)));
+			
+			for ( s = 0; s < 4; ++s )
+			{
+				azimuth_altitude(JD, alpha, delta, L[s], phi[s], &a, &h);
+				c = sin(h * rad) * cos(tilt[s] * rad)
+					+ cos(h * rad) * sin(tilt[s] * rad) * cos((a - gamma[s]) * rad);
+				
+				angle = angle_error(zenith[s * 300 + t], 90 - h, angle);
+				angle = angle_error(A[s * 300 + t], a, angle);
+				incidence = fmax(incidence, fabs(cosIncidence[s * 300 + t] - c));
+			}
+		}
+	}
+	aa_set_isa(isa);
+	
+	printf("solar geometry grid %s\n",
+		( !failed && angle < 1e-8 && incidence < 1e-8 * rad && irradiance < 1e-9 ) ? "agrees" : "differs" );
+}
+
+void poles_test()
+{
+	/* the sun at the poles on 2024 June 20 and December 21, midnight sun in */
+	/* the summer hemisphere and polar night in the other, and the celestial */
+	/* poles seen from Boston: due north at +42.3333 and due south below */
+	static const double day[2] = { 2460481.5, 2460665.5 };
+	static const double delta[2] = { 90, -90 }, alpha[2] = { 0, 0 };
+	double A[3], D[3], m[3], Az[2], h[2];
+	float rise[3 * 2], set[3 * 2];
+	signed char state[3], calendar;
+	aaObserver pole;
+	int i, k, north, expected, wrong = 0;
+	
+	for ( i = 0; i < 2; ++i )
+	{
+		for ( k = 0; k < 3; ++k )
+			app_solar_coordinates(day[i] + k - 1, &A[k], &D[k]);
+		
+		rise_tran_set_raster(day[i], -0.8333, -90, 90, 3, 0, 90, 2, rise, set, NULL, state);
+		
+		for ( north = 0; north < 2; ++north )
+		{
+			/* polar day in the north in June and in the south in December */
+			expected = ( north == (i == 0) ) ? 2 : 0;
+			
+			wrong += rise_tran_set(0, north ? 90 : -90, -0.8333, day[i], A, D, m) != 0;
+			wrong += state[north ? 2 : 0] != expected;
+			
+			observer_init(&pole, 0, north ? 90 : -90, 0, -0.8333);
+			rise_tran_set_calendar(&pole, day[i], 1, m, &calendar);
+			wrong += calendar != expected;
+		}
+	}
+	
+	for ( i = 0; i < 2; ++i )
+	{
+		azimuth_altitude(2460400.3, alpha[i], delta[i], 71.0833, 42.3333, &Az[i], &h[i]);
+		wrong += fabs(h[i] - (i ? -42.3333 : 42.3333)) > 1e-12 || fabs(Az[i]) != (i ? 0 : 180);
+	}
+	azimuth_altitude_n(2460400.3, alpha, delta, 71.0833, 42.3333, Az, h, 2);
+	wrong += fabs(Az[0]) != 180 || Az[1] != 0;
+	
+	printf("poles %d wrong\n", wrong );
+}
+
+void batch_calendar_test()
+{
+	/* date_to_julian_n and julian_to_date_n against the scalar functions at */
+	/* every instruction set, a Gregorian block for the fast loop, the months */
+	/* around the reform of October 1582 and negative years, fractional days: */
+	/* bit for bit, with NaN where the scalar function fails */
+	static short month[1536], m2[1536], mb;
+	static double day[1536], JD[1536], jd[1536], d2[1536], db;
+	static int year[1536], y2[1536], yb;
+	IsaLevels isa = aa_get_isa(), level;
+	int i, ok, wrong = 0;
+	
+	for ( i = 0; i < 1536; ++i )
+	{
+		month[i] = (short) (1 + i % 12);
+		day[i] = 1 + i % 28 + (i % 7) * 0.125;
+		if ( i < 1024 )
+			year[i] = 1583 + i * 3;						/* Gregorian */
+		else if ( i < 1280 )
+		{
+			month[i] = (short) (9 + (i / 28) % 3);		/* 1582 September to November */
+			year[i] = 1582;
+		}
+		else
+			year[i] = -4712 + (i - 1280) * 18;			/* negative years */
+	}
+	
+	for ( level = isa_scalar; level <= isa_avx512; ++level )
+	{
+		if ( !aa_set_isa(level) )
+			continue;
+		
+		date_to_julian_n(month, day, year, JD, 1536);
+		
+		for ( i = 0; i < 1536; ++i )
+		{
+			ok = date_to_julian(month[i], day[i], year[i], &jd[i]);
+			wrong += ok ? JD[i] != jd[i] : JD[i] == JD[i];
+			if ( !ok )
+				jd[i] = 2299160.5 + i * 0.01;			/* around the reform */
+		}
+		
+		julian_to_date_n(jd, m2, d2, y2, 1536);
+		
+		for ( i = 0; i < 1536; ++i )
+		{
+			julian_to_date(jd[i], &mb, &db, &yb);
+			wrong += m2[i] != mb || d2[i] != db || y2[i] != yb;
+		}
+	}
+	aa_set_isa(isa);
+	
+	printf("batch calendar %d wrong\n", wrong );
+}
+
+void timestamp_test()
+{
+	/* ISO 8601 with every zone form, a leap second and 24:00, Unix time with */
+	/* signs and fractions, stamps that must be refused, and a stream cut in */
+	/* the middle of a stamp: all as expected */
+	static const struct { const char *text; double JD; } good[] =
+	{
+		{ "2024-03-01", 2460370.5 },
+		{ "2024-03-01T12:30:15.250Z", 2460370.5 + 45015.25 / 86400 },
+		{ "2024-03-01T12:30+02:00", 2460370.5 + 37800.0 / 86400 },
+		{ "2024-03-01T12:30+0200", 2460370.5 + 37800.0 / 86400 },
+		{ "2024-03-01T12:30+02", 2460370.5 + 37800.0 / 86400 },
+		{ "2024-03-01T12:30-05:30", 2460370.5 + 64800.0 / 86400 },
+		{ "2016-12-31T23:59:60Z", 2457754.5 },
+		{ "2024-03-01T24:00", 2460371.5 },
+		{ "0", 2440587.5 },
+		{ "+1709296215.25", 2440587.5 + 1709296215.25 / 86400 },
+		{ "-86400.5", 2440586.5 - 0.5 / 86400 },
+		{ "999999999999999999", 2440587.5 + 999999999999999999.0 / 86400 }
+	};
+	static const char *bad[] =
+	{
+		"2024-03-01T12:30+02:", "2024-03-01T12:30+02:3", "2023-02-29", "2024-03-01T24:00:01",
+		"2024-03-01T12:30+24", "1234567890123456789", "-", "today"
+	};
+	static const char stream[] = "2024-03-01T12:30Z, 0; 2024-03-01T12:30+02:00";
+	double JD, jd[4];
+	size_t used, more;
+	int i, n, wrong = 0;
+	
+	for ( i = 0; i < (int) (sizeof(good) / sizeof(good[0])); ++i )
+		wrong += !timestamp_to_julian(good[i].text, strlen(good[i].text), &JD)
+			|| fabs(JD - good[i].JD) > 1e-9 * fabs(good[i].JD);
+	
+	for ( i = 0; i < (int) (sizeof(bad) / sizeof(bad[0])); ++i )
+	{
+		JD = -1;
+		wrong += timestamp_to_julian(bad[i], strlen(bad[i]), &JD) || JD != -1;
+	}
+	
+	/* the last stamp is cut after "+02:", it waits for the rest */
+	n = timestamps_to_julian(stream, sizeof(stream) - 4, 0, jd, 4, &used);
+	wrong += n != 2 || used != 22 || jd[0] != 2460370.5 + 45000.0 / 86400 || jd[1] != 2440587.5;
+	n = timestamps_to_julian(stream + used, sizeof(stream) - 1 - used, 1, jd + 2, 2, &more);
+	wrong += n != 1 || used + more != sizeof(stream) - 1 || jd[2] != 2460370.5 + 37800.0 / 86400;
+	
+	printf("time stamps %d wrong\n", wrong );
+}
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <cstdio>
+
+#include "astroalgo.hpp"
+
+/* the constexpr calendar, checked by the compiler */
+constexpr bool within(double a, double b, double tolerance)
+{
+	return a - b <= tolerance && b - a <= tolerance;
+}
+
+/* example 7.a, 1957 October 4.81: JD 2436116.31 */
+static_assert(within(astroalgo::date_to_julian(10, 4.81, 1957), 2436116.31, 1e-6), "example 7.a");
+
+/* example 7.b, 333 January 27.5: JD 1842713.0 */
+static_assert(astroalgo::date_to_julian(1, 27.5, 333) == 1842713.0, "example 7.b");
+
+static_assert(astroalgo::leap_year(1900) == 28 && astroalgo::leap_year(2000) == 29
+	&& astroalgo::leap_year(-4) == 29, "leap years");
+
+void calendar_test();
+void delta_t_test();
+void precision_test();
+
+int main(void)
+{
+	calendar_test();
+	delta_t_test();
+	precision_test();
+
+	return 0;
+}
+
+void calendar_test()
+{
+	static constexpr auto jan1 = astroalgo::new_year_table<2000, 2>();
+	double jd = 0;
+
+	/* the constexpr functions give what the C functions give */
+	date_to_julian(10, 4.81, 1957, &jd);
+	printf("Julian Day is %f, C++ %f\n", jd, astroalgo::date_to_julian(10, 4.81, 1957) );
+	printf("index is %d, C++ %d\n", day_of_week_index(1,1,2008), astroalgo::day_of_week_index(1,1,2008) );
+	printf("2001 January 1 is %.1f\n", jan1[1] );
+}
+
+void delta_t_test()
+{
+	double alpha, delta;
+
+	/* with DeltaT applied the double, instant and C functions take the same UT */
+	aa_set_auto_delta_t(1);
+	::app_solar_coordinates(2448908.5, &alpha, &delta);
+	printf("alpha is %.6f, C++ %.6f, instant %.6f\n", alpha, astroalgo::app_solar_coordinates(2448908.5).alpha,
+		astroalgo::app_solar_coordinates(julian_to_instant(2448908.5)).alpha );
+	printf("float alpha is %.4f, illumination %.6f, C++ %.6f\n",
+		astroalgo::app_solar_coordinates<float>(2448908.5).alpha,
+		::simple_illumination(2448908.5), astroalgo::simple_illumination<float>(2448908.5) );
+	aa_set_auto_delta_t(0);
+}
+
+/* largest difference of two angles in degrees */
+static double angle_error(double a, double b, double error)
+{
+	double d = std::fabs(a - b);
+
+	if ( d > 180 )
+		d = 360 - d;
+	return ( d > error ) ? d : error;
+}
+
+void precision_test()
+{
+	typedef astroalgo::precision<float> F;
+	typedef astroalgo::precision<double> D;
+
+	/* the float policy against the double policy 1900 to 2100 every 0.37 days, */
+	/* a latitude and longitude per date: within the sum of the two bounds */
+	double sun = 0, horizon = 0, illumination = 0;
+	long i;
+
+	for ( i = 0; i * 0.37 < 73050; ++i )
+	{
+		const double JD = 2415020.5 + i * 0.37, theta0 = std::fmod(280.46 + 360.9856 * (JD - 2451545.0), 360.0);
+		const float phi = float(i % 181 - 90), L = float(i * 7 % 360 - 180);
+		const astroalgo::equatorial<float> ef = astroalgo::app_solar_coordinates<float>(JD);
+		const astroalgo::equatorial<double> ed = astroalgo::app_solar_coordinates<double>(JD);
+		const astroalgo::horizontal<float> hf = astroalgo::azimuth_altitude_sidereal<float>(theta0,
+			float(ed.alpha), float(ed.delta), L, phi);
+		const astroalgo::horizontal<double> hd = astroalgo::azimuth_altitude_sidereal<double>(theta0,
+			double(float(ed.alpha)), double(float(ed.delta)), L, phi);
+
+		sun = angle_error(ef.alpha, ed.alpha, sun);
+		sun = angle_error(ef.delta, ed.delta, sun);
+		horizon = angle_error(hf.h, hd.h, horizon);
+		horizon = std::fmax(angle_error(hf.A, hd.A, 0) * std::cos(hd.h * D::deg_rad), horizon);
+		illumination = angle_error(astroalgo::simple_illumination<float>(JD), astroalgo::simple_illumination<double>(JD),
+			illumination);
+	}
+
+	printf("float policy %s\n", ( sun <= F::solar_coordinates_error + D::solar_coordinates_error
+		&& horizon <= F::azimuth_altitude_error + D::azimuth_altitude_error
+		&& illumination <= F::illumination_error + D::illumination_error ) ? "within bounds" : "outside bounds" );
+}